@@ -1,7 +1,77 @@
 // #include <stdio.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
+#ifdef SMALL_STRTOD_SWAR
+// Optional parsing of 8 decimal digits at once, intended for 64-bit hosts.
+// Off by default, so default build keeps its minimal code footprint.
+
+// 8-byte load may read up to 7 bytes beyond the terminating zero. It never crosses page boundary,
+// so it can't fault, but AddressSanitizer reports it, so under sanitizer SWAR is not used
+#if defined(__SANITIZE_ADDRESS__)
+#define SMALL_STRTOD_SWAR_NO_OVERREAD 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SMALL_STRTOD_SWAR_NO_OVERREAD 1
+#endif
+#endif
+
+static int swarCanLoad8(const char* p)
+{ // 8-byte load at p does not cross page boundary
+#ifdef SMALL_STRTOD_SWAR_NO_OVERREAD
+  (void)p;
+  return 0;
+#else
+  return ((uintptr_t)p & 4095) <= 4096-8;
+#endif
+}
+
+static uint64_t swarLoad8(const char* p)
+{
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  w = __builtin_bswap64(w); // first character in LS byte
+#endif
+  return w;
+}
+
+static int swarIs8Digits(uint64_t w)
+{ // each byte in range ['0':'9']
+  return ((w & 0xF0F0F0F0F0F0F0F0) | (((w + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+         == 0x3333333333333333;
+}
+
+static uint32_t swarParse8Digits(uint64_t w)
+{ // w = 8 ASCII digits, the most significant in LS byte
+  w &= 0x0F0F0F0F0F0F0F0F;
+  w = (w * (10*256+1)) >> 8;                                  // 4 x 2 digits
+  w = ((w & 0x00FF00FF00FF00FF) * (100*65536+1)) >> 16;       // 2 x 4 digits
+  w = ((w & 0x0000FFFF0000FFFF) * ((10000ull << 32)+1)) >> 32; // 1 x 8 digits
+  return (uint32_t)w;
+}
+
+// consume 8 digits at once as long as all of them would be used by the main loop,
+// i.e. as long as *pVal*10**7 + 9999999 <= (UINT64_MAX-9)/10
+// return # of consumed digits
+static ptrdiff_t swarReadDigits(const char* src, uint64_t* pVal)
+{
+  const uint64_t swarLim = ((UINT64_MAX-9)/10 - 9999999)/10000000 + 1;
+  uint64_t val = *pVal;
+  ptrdiff_t nd = 0;
+  while (val < swarLim && swarCanLoad8(&src[nd])) {
+    uint64_t w = swarLoad8(&src[nd]);
+    if (!swarIs8Digits(w))
+      break;
+    val = val*100000000 + swarParse8Digits(w);
+    nd += 8;
+  }
+  *pVal = val;
+  return nd;
+}
+#endif
+
 static const char *skipWhiteSpaces(const char *str)
 { // skip leading white spaces
   while (*str && *str <= ' ') ++str;
@@ -42,7 +112,9 @@ static uint64_t to_double(uint64_t mant, int exp)
 }
 
 double
-__attribute ((cold))
+#ifndef SMALL_STRTOD_SWAR
+__attribute ((cold)) // SWAR variant is meant for speed, while cold functions are optimized for size
+#endif
 small_strtod(const char* str, char** endptr)
 {
   const char* p = skipWhiteSpaces(str);
@@ -66,6 +138,13 @@ small_strtod(const char* str, char** endptr)
   int nege;
   const int MAX_EXP =  310;
   const int MIN_EXP = -345;
+#ifdef SMALL_STRTOD_SWAR
+  { // the beginning of integer part of mantissa
+    ptrdiff_t nd = swarReadDigits(p, &rdVal);
+    succ = (nd != 0);
+    p   += nd;
+  }
+#endif
   for (;;) {
     unsigned c = *p++;
     unsigned dig = c - '0';
@@ -78,6 +157,17 @@ small_strtod(const char* str, char** endptr)
         --rdExp;
       } else {
         lsbits |= dig;
+#ifdef SMALL_STRTOD_SWAR
+        // the rest of digits only contribute to sticky bit
+        while (swarCanLoad8(p)) {
+          uint64_t w = swarLoad8(p);
+          if (!swarIs8Digits(w))
+            break;
+          lsbits |= ((w & 0x0F0F0F0F0F0F0F0F) != 0);
+          rdExp  += parseState*8;
+          p += 8;
+        }
+#endif
       }
     } else {
       // non-digit
@@ -85,6 +175,14 @@ small_strtod(const char* str, char** endptr)
         if (parseState == PARSE_INT) {
           if (c == '.') {
             parseState = PARSE_FRACT;
+#ifdef SMALL_STRTOD_SWAR
+            { // the beginning of fraction part of mantissa
+              ptrdiff_t nd = swarReadDigits(p, &rdVal);
+              succ  |= (nd != 0);
+              rdExp -= nd;
+              p     += nd;
+            }
+#endif
             continue;
           }
         }
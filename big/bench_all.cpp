@@ -0,0 +1,591 @@
+// Run speed test of all strtod() implementations of the project, and of C RTL strtod(), on the list
+// of test vectors from how-to-test.txt. Print results in the layout of results.csv: a column per
+// implementation, header rows with CPU, OS and compiler, then a row of nsec/iter per test vector.
+// Implementations with the same names of external functions are compiled with renamed symbols,
+// see build instructions in readme.txt.
+#ifdef _MSC_VER
+ #define _CRT_SECURE_NO_WARNINGS
+#endif
+#include <cstdint>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cfenv>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include "test_vector.h"
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define BENCH_HAS_CPUID
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <cpuid.h>
+ #define BENCH_HAS_CPUID
+#endif
+#ifndef _WIN32
+ #include <sys/utsname.h>
+#endif
+#ifdef __APPLE__
+ #include <sys/sysctl.h>
+#endif
+#ifdef __GLIBC__
+ #include <gnu/libc-version.h>
+#endif
+
+extern "C" {
+double my_strtod_c(const char* str, char** str_end);      // my_strtod.c,   -Dmy_strtod=my_strtod_c
+double my_strtod(const char* str, char** str_end);        // my_strtod99.c
+double small_strtod(const char* str, char** str_end);     // ../small_strtod.c
+double small_strtod_64b(const char* str, char** str_end); // ../64b_small_strtod.c, -Dsmall_strtod=small_strtod_64b
+double small_strtod_n2(const char* str, char** str_end);  // ../n2_small_strtod.c,  -Dsmall_strtod=small_strtod_n2
+double small_strtod_w3(const char* str, char** str_end);  // ../w3_small_strtod.c,  -Dsmall_strtod=small_strtod_w3
+}
+
+static double clib_strtod(const char* str, char** str_end) {
+  return strtod(str, str_end);
+}
+
+static uint64_t d2u(double x) {
+  uint64_t y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
+// Speed test loop. Instantiated per implementation, so conversion is called directly,
+// like in clib_test
+template<double (*cvt)(const char*, char**)>
+static uint64_t speedLoop(char* const* inp, size_t n)
+{
+  uint64_t dummy = 0;
+  for (size_t k = 0; k < n; ++k)
+    dummy += d2u(cvt(inp[k], NULL));
+  return dummy;
+}
+
+struct engine_t {
+  const char* name;
+  double   (*cvt)(const char*, char**);
+  uint64_t (*loop)(char* const* inp, size_t n);
+};
+
+#define ENGINE(name, fn) { name, fn, speedLoop<fn> }
+static engine_t engines[] = {
+  ENGINE("C RTL",            clib_strtod),     // name is replaced by version of C RTL, when known
+  ENGINE("my_strtod",        my_strtod_c),
+  ENGINE("my_strtod99",      my_strtod),
+  ENGINE("small_strtod",     small_strtod),
+  ENGINE("64b_small_strtod", small_strtod_64b),
+  ENGINE("n2_small_strtod",  small_strtod_n2),
+  ENGINE("w3_small_strtod",  small_strtod_w3),
+};
+#undef ENGINE
+enum { N_ENGINES = sizeof(engines)/sizeof(engines[0]) };
+
+// item of the list of test vectors
+struct test_file_t {
+  std::string name;
+  long        nRep;
+};
+
+// Read test vectors and numbers of repetitions from section "How to run tests:" of how-to-test.txt,
+// i.e. from lines like "./clib_test t1.txt 100"
+static bool readTestList(const char* listName, std::vector<test_file_t>* list)
+{
+  FILE* fp = fopen(listName, "r");
+  if (!fp) {
+    perror(listName);
+    return false;
+  }
+  char line[1024];
+  bool inSection = false;
+  while (fgets(line, sizeof(line), fp)) {
+    if (strncmp(line, "How to run tests:", 17) == 0) {
+      inSection = true;
+      continue;
+    }
+    if (!inSection)
+      continue;
+    char name[512];
+    long nRep = 1;
+    int n = sscanf(line, "./clib_test %511s %ld", name, &nRep);
+    if (n < 1)
+      break; // end of section
+    test_file_t tf;
+    tf.name = name;
+    tf.nRep = n == 2 && nRep > 0 ? nRep : 1;
+    list->push_back(tf);
+  }
+  fclose(fp);
+  if (list->empty()) {
+    fprintf(stderr, "%s: no test vectors found in section 'How to run tests:'.\n", listName);
+    return false;
+  }
+  return true;
+}
+
+static std::string trim(const char* s)
+{
+  while (*s == ' ' || *s == '\t')
+    ++s;
+  std::string ret = s;
+  while (!ret.empty() && (unsigned char)ret.back() <= ' ')
+    ret.pop_back();
+  return ret;
+}
+
+static std::string cpuModel()
+{
+#ifdef BENCH_HAS_CPUID
+  // brand string of x86 CPUs, leaves 0x80000002-0x80000004
+  unsigned regs[12] = {0};
+ #ifdef _MSC_VER
+  int r[4];
+  __cpuid(r, 0x80000000);
+  if (unsigned(r[0]) >= 0x80000004) {
+    for (int i = 0; i < 3; ++i)
+      __cpuid((int*)&regs[i*4], 0x80000002 + i);
+  }
+ #else
+  if (__get_cpuid_max(0x80000000, NULL) >= 0x80000004) {
+    for (unsigned i = 0; i < 3; ++i)
+      __get_cpuid(0x80000002 + i, &regs[i*4+0], &regs[i*4+1], &regs[i*4+2], &regs[i*4+3]);
+  }
+ #endif
+  char brand[sizeof(regs)+1];
+  memcpy(brand, regs, sizeof(regs));
+  brand[sizeof(regs)] = 0;
+  if (brand[0])
+    return trim(brand);
+#endif
+#ifdef __APPLE__
+  char brand[256];
+  size_t len = sizeof(brand);
+  if (sysctlbyname("machdep.cpu.brand_string", brand, &len, NULL, 0) == 0)
+    return trim(brand);
+#endif
+  // Linux on other architectures
+  FILE* fp = fopen("/proc/cpuinfo", "r");
+  if (fp) {
+    static const char* keys[] = { "model name", "Model", "cpu model", "cpu", "Hardware" };
+    std::string ret;
+    char line[512];
+    for (const char* key : keys) {
+      rewind(fp);
+      while (ret.empty() && fgets(line, sizeof(line), fp)) {
+        size_t klen = strlen(key);
+        if (strncmp(line, key, klen) == 0 && (line[klen] == ':' || line[klen] == ' ' || line[klen] == '\t')) {
+          const char* colon = strchr(line, ':');
+          if (colon)
+            ret = trim(colon + 1);
+        }
+      }
+      if (!ret.empty())
+        break;
+    }
+    fclose(fp);
+    if (!ret.empty())
+      return ret;
+  }
+  return "unknown";
+}
+
+static std::string osName()
+{
+#ifdef _WIN32
+  return "Windows";
+#else
+  struct utsname u;
+  if (uname(&u) != 0)
+    return "unknown";
+  return std::string(u.sysname) + " " + u.release;
+#endif
+}
+
+static std::string compilerName()
+{
+  char buf[128];
+#if defined(__clang__)
+  snprintf(buf, sizeof(buf), "clang %s", __clang_version__);
+#elif defined(__GNUC__)
+  snprintf(buf, sizeof(buf), "gcc %s", __VERSION__);
+#elif defined(_MSC_FULL_VER)
+  snprintf(buf, sizeof(buf), "MSVC %d.%d.%d", _MSC_FULL_VER / 10000000,
+    _MSC_FULL_VER / 100000 % 100, _MSC_FULL_VER % 100000);
+#else
+  snprintf(buf, sizeof(buf), "unknown");
+#endif
+  return trim(buf);
+}
+
+// print CSV field, quoted when necessary
+static void printField(const std::string& s)
+{
+  if (s.find_first_of(",\"\n") == std::string::npos) {
+    printf(",%s", s.c_str());
+    return;
+  }
+  printf(",\"");
+  for (char c : s) {
+    if (c == '"')
+      putchar('"');
+    putchar(c);
+  }
+  putchar('"');
+}
+
+static void printHeaderRow(const char* title, const std::string& val, size_t nColumns)
+{
+  printf("%s", title);
+  for (size_t i = 0; i < nColumns; ++i)
+    printField(val);
+  printf("\n");
+}
+
+// split line of CSV file into fields
+static std::vector<std::string> splitCsvLine(const char* line)
+{
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (const char* p = line; *p && *p != '\n' && (*p != '\r' || quoted); ++p) {
+    if (quoted) {
+      if (*p != '"')
+        fields.back() += *p;
+      else if (p[1] == '"')
+        fields.back() += *p++;
+      else
+        quoted = false;
+    } else if (*p == '"') {
+      quoted = true;
+    } else if (*p == ',') {
+      fields.push_back(std::string());
+    } else {
+      fields.back() += *p;
+    }
+  }
+  return fields;
+}
+
+// Parse cell of CSV, made in median mode: "median [lo:hi]"
+static bool parseInterval(const std::string& val, double* median, double* lo, double* hi)
+{
+  return sscanf(val.c_str(), "%lf [%lf :%lf ]", median, lo, hi) == 3 && *lo <= *median && *median <= *hi;
+}
+
+// baseline of regression test, in the layout of results.csv
+struct baseline_t {
+  std::vector<std::string> columns;               // names of implementations from row 'test file'
+  std::vector<std::string> files;                 // names of test vectors
+  std::vector<std::vector<std::string>> values;   // "median [lo:hi]" nsec/iter, values[file][column]
+
+  // Return NULL when not found
+  const std::string* find(const std::string& file, const std::string& column) const {
+    for (size_t fi = 0; fi < files.size(); ++fi) {
+      if (files[fi] != file)
+        continue;
+      for (size_t ci = 0; ci < columns.size() && ci < values[fi].size(); ++ci)
+        if (trim(columns[ci].c_str()) == column && !trim(values[fi][ci].c_str()).empty())
+          return &values[fi][ci];
+    }
+    return NULL;
+  }
+};
+
+static bool readBaseline(const char* name, baseline_t* base)
+{
+  FILE* fp = fopen(name, "r");
+  if (!fp) {
+    perror(name);
+    return false;
+  }
+  char line[4096];
+  while (fgets(line, sizeof(line), fp)) {
+    std::vector<std::string> fields = splitCsvLine(line);
+    std::string first = fields[0];
+    fields.erase(fields.begin());
+    if (first == "test file") {
+      base->columns = fields;
+    } else if (!base->columns.empty() && !first.empty()) {
+      base->files.push_back(first);
+      base->values.push_back(fields);
+    }
+  }
+  fclose(fp);
+  if (base->columns.empty()) {
+    fprintf(stderr, "%s: row 'test file' not found.\n", name);
+    return false;
+  }
+  // the same statistic on both sides of comparison: baseline must be made with -median
+  for (size_t fi = 0; fi < base->files.size(); ++fi) {
+    for (size_t ci = 0; ci < base->values[fi].size(); ++ci) {
+      const std::string& val = base->values[fi][ci];
+      double median, lo, hi;
+      if (!trim(val.c_str()).empty() && !parseInterval(val, &median, &lo, &hi)) {
+        fprintf(stderr, "%s: '%s' of %s is not a median with confidence interval."
+          " Baseline must be made by bench_all -median.\n", name, trim(val.c_str()).c_str(), base->files[fi].c_str());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Distribution-free confidence interval of median of sorted samples x[0:n-1]: [x[j]:x[n-1-j]],
+// where j is the largest index, such that probability that no more than j of n samples fall below
+// median does not exceed 2.5%. Return confidence level of the interval, which is 95% or more when n >= 6.
+// For smaller n the interval is the whole range of samples.
+static double medianCI(const std::vector<double>& x, double* lo, double* hi)
+{
+  size_t n = x.size();
+  double p = std::ldexp(1.0, -int(n)); // P(B == j), B ~ binomial(n, 0.5)
+  double cdf = p;                      // P(B <= j)
+  size_t j = 0;
+  while (j+1 <= (n-1)/2 && cdf + p*(n-j)/(j+1) <= 0.025) {
+    p = p*(n-j)/(j+1);
+    cdf += p;
+    ++j;
+  }
+  *lo = x[j];
+  *hi = x[n-1-j];
+  return 1.0 - 2*cdf;
+}
+
+int main(int argz, char** argv)
+{
+  const char* listName = "how-to-test.txt";
+  const char* baseName = NULL;
+  std::string dir;
+  std::string reportedBy;
+  std::string only;
+  int nRuns = 0;
+  double threshold = 5.0;
+  bool medianOpt = false;
+  for (int arg_i = 1; arg_i < argz; ++arg_i) {
+    const char* arg = argv[arg_i];
+    if (strncmp(arg, "-list=", 6) == 0) {
+      listName = &arg[6];
+    } else if (strncmp(arg, "-dir=", 5) == 0) {
+      dir = &arg[5];
+      if (!dir.empty() && dir.back() != '/' && dir.back() != '\\')
+        dir += '/';
+    } else if (strncmp(arg, "-by=", 4) == 0) {
+      reportedBy = &arg[4];
+    } else if (strncmp(arg, "-only=", 6) == 0) {
+      only = std::string(",") + &arg[6] + ",";
+    } else if (strcmp(arg, "-median") == 0) {
+      medianOpt = true;
+    } else if (strncmp(arg, "-base=", 6) == 0) {
+      baseName = &arg[6];
+    } else if (strncmp(arg, "-thr=", 5) == 0) {
+      char* endp;
+      threshold = strtod(&arg[5], &endp);
+      if (endp == &arg[5] || *endp != 0 || !(threshold >= 0 && threshold <= 1000)) {
+        fprintf(stderr, "Illegal threshold '%s'. Range [0:1000] percents.\n", &arg[5]);
+        return 1;
+      }
+    } else if (strncmp(arg, "-runs=", 6) == 0) {
+      char* endp;
+      long val = strtol(&arg[6], &endp, 0);
+      if (endp == &arg[6] || *endp != 0 || val < 1 || val > 100) {
+        fprintf(stderr, "Illegal number of runs '%s'. Range [1:100].\n", &arg[6]);
+        return 1;
+      }
+      nRuns = int(val);
+    } else {
+      fprintf(stderr,
+        "Usage:\n%s [-list=file] [-dir=path] [-runs=nRuns] [-by=name] [-only=names] [-median] [-base=baseline] [-thr=percents]\n"
+        "where\n"
+        " file      - [optional] list of test vectors and numbers of repetitions,\n"
+        "             section 'How to run tests:' of how-to-test.txt. Default how-to-test.txt\n"
+        " path      - [optional] directory of test vectors. Default - current directory\n"
+        " nRuns     - [optional] number of runs of speed test. The fastest is reported, in median and\n"
+        "             regression modes the median. Default 3, in median and regression modes 9\n"
+        " name      - [optional] content of row 'Reported by'\n"
+        " names     - [optional] comma-separated names of implementations to run, as in row 'test file'.\n"
+        "             Default - all\n"
+        " -median   - [optional] report median of runs with its 95%% confidence interval, 'median [lo:hi]'\n"
+        " baseline  - [optional] regression mode, implies -median. Compare confidence intervals with baseline,\n"
+        "             output of previous run of bench_all -median on the same machine\n"
+        " percents  - [optional] regression threshold. Default 5\n"
+        "CSV is printed to standard output, progress and correctness to standard error.\n"
+        "In regression mode exit code is 2 when any implementation is slower than baseline by more than\n"
+        "the threshold: lower end of interval is above upper end of baseline interval by more than threshold.\n"
+        , argv[0]);
+      return 1;
+    }
+  }
+  const bool regressionMode = baseName != NULL;
+  const bool medianMode = medianOpt || regressionMode;
+  if (nRuns == 0)
+    nRuns = medianMode ? 9 : 3;
+
+  std::vector<test_file_t> list;
+  if (!readTestList(listName, &list))
+    return 1;
+
+  baseline_t base;
+  if (regressionMode && !readBaseline(baseName, &base))
+    return 1;
+
+#ifdef __GLIBC__
+  std::string clibName = std::string("glibc ") + gnu_get_libc_version();
+  engines[0].name = clibName.c_str();
+#elif defined(_MSC_VER)
+  engines[0].name = "MSVC C RTL";
+#endif
+
+  std::vector<int> sel; // indices of selected implementations
+  for (int ei = 0; ei < N_ENGINES; ++ei)
+    if (only.empty() || only.find(std::string(",") + engines[ei].name + ",") != std::string::npos)
+      sel.push_back(ei);
+  if (sel.empty()) {
+    fprintf(stderr, "No implementation matches -only=%s.\n", only.substr(1, only.size()-2).c_str());
+    return 1;
+  }
+  const size_t nSel = sel.size();
+
+  // nsec/iter of every run, samples[file][selected implementation]. Filled before anything is printed,
+  // so progress messages don't mix with CSV
+  std::vector<std::vector<std::vector<double>>> samples(list.size(), std::vector<std::vector<double>>(nSel));
+  for (size_t fi = 0; fi < list.size(); ++fi) {
+    std::string fileName = dir + list[fi].name;
+    test_vector_t tv;
+    if (!loadTestVector(fileName.c_str(), &tv)) {
+      fprintf(stderr, "%s: skipped.\n", fileName.c_str());
+      continue;
+    }
+    if (tv.f32) {
+      fprintf(stderr, "%s: binary32 test vector. Skipped.\n", fileName.c_str());
+      continue;
+    }
+    const size_t nItems = tv.srcv.size();
+    const long   nRep   = list[fi].nRep;
+    fprintf(stderr, "%s: %zu items x %ld.", fileName.c_str(), nItems, nRep);
+
+    // correctness. small_strtod variants are not always correctly rounded, so errors are reported, but
+    // do not stop the test. Ties broken to odd are not errors, the same as in clib_test
+    fesetround(tv.roundingMode);
+    for (size_t si = 0; si < nSel; ++si) {
+      const engine_t& e = engines[sel[si]];
+      size_t nErrors = 0, nTiesBrokenToOdd = 0;
+      for (size_t k = 0; k < nItems; ++k) {
+        uint64_t u = d2u(e.cvt(tv.srcv[k], NULL));
+        if (u != tv.expected[k]) {
+          if (tv.isTieBrokenToOdd(k, u))
+            ++nTiesBrokenToOdd;
+          else
+            ++nErrors;
+        }
+      }
+      if (nErrors)
+        fprintf(stderr, " %s: %zu errors.", e.name, nErrors);
+      if (nTiesBrokenToOdd)
+        fprintf(stderr, " %s: %zu ties broken to odd.", e.name, nTiesBrokenToOdd);
+    }
+    fesetround(FE_TONEAREST);
+
+    // the same plan of timing test as in clib_test, shared by all implementations
+    std::vector<char*> rndinp(nItems*nRep);
+    for (size_t k = 0; k < nItems; ++k)
+      for (long i = 0; i < nRep; ++i)
+        rndinp[k*nRep+i] = tv.srcv[k];
+    std::mt19937_64 gen;
+    gen.seed(1);
+    std::shuffle(rndinp.begin(), rndinp.end(), gen);
+
+    // runs of different implementations are interleaved, so slow drift of clock frequency
+    // affects all of them alike
+    uint64_t dummy = 0;
+    for (int run = 0; run < nRuns; ++run) {
+      for (size_t si = 0; si < nSel; ++si) {
+        fesetround(tv.roundingMode);
+        auto t0 = std::chrono::steady_clock::now();
+        dummy += engines[sel[si]].loop(rndinp.data(), rndinp.size());
+        auto t1 = std::chrono::steady_clock::now();
+        fesetround(FE_TONEAREST);
+        auto nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+        samples[fi][si].push_back(double(nsec.count())/rndinp.size());
+      }
+    }
+    fprintf(stderr, " (%" PRIu64 ")\n", dummy % 10);
+  }
+
+  // reported value: the fastest run or, in median mode, the median and its confidence interval
+  struct result_t {
+    double nsec, lo, hi; // nsec < 0 - not measured
+  };
+  std::vector<std::vector<result_t>> results(list.size(), std::vector<result_t>(nSel, result_t{-1.0, 0, 0}));
+  int nRegressions = 0;
+  if (regressionMode)
+    fprintf(stderr, "%-20s %-20s %9s %17s %9s %20s %8s\n",
+      "test file", "implementation", "baseline", "baseline interval", "median", "confidence interval", "change");
+  for (size_t fi = 0; fi < list.size(); ++fi) {
+    for (size_t si = 0; si < nSel; ++si) {
+      std::vector<double>& x = samples[fi][si];
+      if (x.empty())
+        continue;
+      std::sort(x.begin(), x.end());
+      size_t n = x.size();
+      result_t& res = results[fi][si];
+      if (!medianMode) {
+        res.nsec = x[0];
+        continue;
+      }
+      double median = n % 2 ? x[n/2] : (x[n/2-1] + x[n/2])*0.5;
+      double level = medianCI(x, &res.lo, &res.hi);
+      res.nsec = median;
+      if (!regressionMode)
+        continue;
+      const char* name = engines[sel[si]].name;
+      const std::string* baseVal = base.find(list[fi].name, name);
+      if (!baseVal) {
+        fprintf(stderr, "%-20s %-20s %9s %17s %9.2f [%7.2f:%7.2f] %2.0f%%\n",
+          list[fi].name.c_str(), name, "-", "-", median, res.lo, res.hi, level*100);
+        continue;
+      }
+      double baseNsec, baseLo, baseHi;
+      parseInterval(*baseVal, &baseNsec, &baseLo, &baseHi); // validated by readBaseline()
+      // slower beyond threshold: both intervals are of the median, the current one lies above
+      // the baseline one with the margin of threshold
+      bool regression = baseHi > 0 && res.lo > baseHi*(1 + threshold*0.01);
+      nRegressions += regression;
+      fprintf(stderr, "%-20s %-20s %9.2f [%7.2f:%7.2f] %9.2f [%7.2f:%7.2f] %2.0f%% %+7.1f%%%s\n",
+        list[fi].name.c_str(), name, baseNsec, baseLo, baseHi, median, res.lo, res.hi, level*100,
+        baseNsec > 0 ? (median/baseNsec - 1)*100 : 0.0, regression ? " REGRESSION" : "");
+    }
+  }
+
+  // the same layout as results.csv
+  for (int i = 0; i < 5; ++i)
+    printHeaderRow("", "", nSel);
+  printHeaderRow("Reported by", reportedBy,     nSel);
+  printHeaderRow("CPU",         cpuModel(),     nSel);
+  printHeaderRow("OS",          osName(),       nSel);
+  printHeaderRow("compiler",    compilerName(), nSel);
+  printf("test file");
+  for (size_t si = 0; si < nSel; ++si)
+    printField(engines[sel[si]].name);
+  printf("\n");
+  for (size_t fi = 0; fi < list.size(); ++fi) {
+    printf("%s", list[fi].name.c_str());
+    for (size_t si = 0; si < nSel; ++si) {
+      const result_t& res = results[fi][si];
+      if (res.nsec < 0)
+        printf(",");
+      else if (medianMode)
+        printf(",%.2f [%.2f:%.2f]", res.nsec, res.lo, res.hi);
+      else
+        printf(",%.2f", res.nsec);
+    }
+    printf("\n");
+  }
+
+  if (nRegressions > 0) {
+    fprintf(stderr, "%d regression(s) beyond %.1f%% threshold.\n", nRegressions, threshold);
+    return 2;
+  }
+  return 0;
+}
@@ -7,10 +7,15 @@
 #include <cstdlib>
 #include <cstring>
 #include <cfenv>
+#include <cmath>
 #include <random>
 #include <vector>
+#include <string>
+#include <thread>
 #include <chrono>
 #include <algorithm>
+#include "test_vector.h"
+#include "perf_counters.h"
 
 #ifdef MY_STRTOD
  extern "C" double my_strtod(const char* str, char** str_end);
@@ -19,113 +24,417 @@
  #define uut_strtod strtod
 #endif
 
+#ifdef MY_STRTOF
+ extern "C" float my_strtof(const char* str, char** str_end);
+ #define uut_strtof my_strtof
+#else
+ #define uut_strtof strtof
+#endif
+
+#ifdef MY_STRTOD_BATCH
+ extern "C" void my_strtod_batch(const char* const str[], double res[], char* str_end[], size_t n);
+ #define uut_strtod_batch my_strtod_batch
+#else
+static void uut_strtod_batch(const char* const str[], double res[], char* str_end[], size_t n)
+{ // reference batch - a loop of per-call conversions
+  for (size_t i = 0; i < n; ++i)
+    res[i] = uut_strtod(str[i], str_end ? &str_end[i] : NULL);
+}
+#endif
+
+#ifdef MY_STRTOD_N
+ extern "C" double my_strtod_n(const char* first, const char* last, char** str_end);
+ #define uut_strtod_n my_strtod_n
+#else
+static double uut_strtod_n(const char* first, const char* last, char** str_end)
+{ // reference - conversion of zero-terminated copy
+  char sbuf[4096];
+  std::vector<char> dbuf;
+  size_t len = size_t(last - first);
+  char* buf = sbuf;
+  if (len >= sizeof(sbuf)) {
+    dbuf.resize(len+1);
+    buf = dbuf.data();
+  }
+  memcpy(buf, first, len);
+  buf[len] = 0;
+  char* endp;
+  double res = uut_strtod(buf, &endp);
+  if (str_end)
+    *str_end = (char*)first + (endp - buf);
+  return res;
+}
+#endif
+
+#ifdef MY_STRTOD_STATS
+ #include "my_strtod_stats.h"
+// Print counters of decision points of alternative implementation as percentages of conversions
+static void printStats(void)
+{
+  my_strtod_stats_t st;
+  my_strtod_stats_get(&st);
+  double pct = st.nCalls ? 100.0/st.nCalls : 0;
+  printf("stats: %" PRIu64 " calls. quick %.2f%%, slow %.2f%% (int %.2f%%, frac %.2f%%)"
+    ", exact %.2f%%, fpu %.2f%%, hex %.2f%%, inf/nan %.2f%%, over/underflow %.2f%%\n"
+    , st.nCalls
+    , st.nQuickDone*pct
+    , st.nSlow*pct
+    , st.nSlowInt*pct
+    , st.nSlowFrac*pct
+    , st.nExact*pct
+    , st.nFpuFast*pct
+    , st.nHex*pct
+    , st.nInfNan*pct
+    , st.nOverUnder*pct
+    );
+}
+#endif
+
+#ifdef MY_FROM_CHARS
+ #include "my_from_chars.h"
+static double uut_from_chars(const char* first, const char* last, char** str_end)
+{
+  double res = 0;
+  my::from_chars_result r = my::from_chars(first, last, res);
+  if (r.ec == std::errc::result_out_of_range) {
+    // value is not stored. Return result of strtod(), as long as it is zero or Inf
+    res = uut_strtod_n(first, last, NULL);
+    if (res != 0 && !std::isinf(res))
+      res = std::nan("");
+  } else if (r.ec != std::errc()) {
+    r.ptr = first;
+  }
+  if (str_end)
+    *str_end = (char*)r.ptr;
+  return res;
+}
+#else
+ #define uut_from_chars uut_strtod_n // reference
+#endif
+
 static uint64_t d2u(double x) {
   uint64_t y;
   memcpy(&y, &x, sizeof(y));
   return y;
 }
 
+#ifndef MY_FROM_CHARS_HEADER_ONLY // otherwise the same u2d() comes from my_strtod99.c
 static double u2d(uint64_t x) {
   double y;
   memcpy(&y, &x, sizeof(y));
   return y;
 }
+#endif
+
+static uint64_t f2u(float x) {
+  uint32_t y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
+static float u2f(uint64_t x) {
+  uint32_t y = uint32_t(x);
+  float z;
+  memcpy(&z, &y, sizeof(z));
+  return z;
+}
+
+// Key of sorted order of timing test: number of significant digits and decimal exponent of
+// the most significant digit. Inputs without decimal digits (inf, nan, hexadecimal) get key (0,0)
+static void orderKey(const char* str, int* nSig, long* sciExp)
+{
+  while (*str == ' ' || *str == '\t') ++str;
+  if (*str == '+' || *str == '-') ++str;
+  int nDig = 0, nInt = 0, firstSig = -1;
+  bool point = false;
+  for (;; ++str) {
+    if (*str >= '0' && *str <= '9') {
+      if (firstSig < 0 && *str != '0')
+        firstSig = nDig;
+      ++nDig;
+      nInt += !point;
+    } else if (*str == '.' && !point) {
+      point = true;
+    } else {
+      break;
+    }
+  }
+  long exp = 0;
+  if (*str == 'e' || *str == 'E')
+    exp = strtol(str+1, NULL, 10);
+  if (firstSig < 0 || *str == 'x' || *str == 'X') {
+    *nSig = 0;
+    *sciExp = 0;
+    return;
+  }
+  *nSig = nDig - firstSig;
+  *sciExp = exp + nInt - 1 - firstSig;
+}
+
+// Read every cache line of buf, evicting whatever was cached before
+static uint64_t evictCaches(const std::vector<uint64_t>& buf)
+{
+  const volatile uint64_t* p = buf.data();
+  uint64_t acc = 0;
+  for (size_t i = 0; i < buf.size(); i += 64/sizeof(uint64_t))
+    acc += p[i];
+  return acc;
+}
+
+enum { MAX_REPORTED_ERRORS = 1000 };
+
+// result of correctness test of a range of test vector
+struct check_result_t {
+  int nErrors;
+  int nTiesBrokenToOdd;
+  std::vector<std::string> failures; // descriptions of the first MAX_REPORTED_ERRORS failures
+  check_result_t() : nErrors(0), nTiesBrokenToOdd(0) {}
+};
 
 int main(int argz, char** argv)
 {
   if (argz < 2) {
-    fprintf(stderr, "Usage:\n%s inp-file-name [nRep]\n", argv[0]);
+    fprintf(stderr,
+      "Usage:\n%s inp-file-name [nRep] [-b | -n | -f] [-j[=nThreads]] [-perf] [-lat]\n"
+      "  [-order=shuffled|original|sorted] [-place=file|pool|scatter] [-cold[=nConversions]]\n"
+      "where\n"
+      "inp-file-name - test vector in text format or binary container, written by gen_test -bin=file\n"
+      "nRep - [optional] number of repetition during speed test. Default 1.\n"
+      "-b   - [optional] test batch conversion in addition to per-call conversion\n"
+      "-n   - [optional] test conversion of strings that are not zero-terminated\n"
+      "-f   - [optional] test from_chars() conversion of strings that are not zero-terminated\n"
+      "-j   - [optional] run correctness test in nThreads threads. Default - number of hardware threads.\n"
+      "       Report is the same as in single thread. Speed test always runs in single thread\n"
+      "-perf - [optional] report hardware counters of speed test: cycles, instructions, IPC,\n"
+      "       branch mispredictions and L1d misses per conversion. Uses perf_event_open(),\n"
+      "       falls back to rdtsc when it is not available\n"
+      "-lat  - [optional] measure latency in addition to throughput. Input of each conversion\n"
+      "       depends on the result of the previous conversion\n"
+      "-order - [optional] order of inputs in speed test. Default - shuffled. original - as in test vector,\n"
+      "       sorted - by number of significant digits, then by decimal exponent\n"
+      "-place - [optional] placement of input strings in memory during speed test. Default - file, i.e.\n"
+      "       where they are in test vector. pool - copied back to back into cache-line aligned pool in\n"
+      "       order of the first use, scatter - every string in its own cache line, lines in random order\n"
+      "-cold - [optional] in addition, time nConversions (default 10000) single conversions with caches\n"
+      "       evicted before each of them\n"
+      , argv[0]);
     return 1;
   }
 
   long nRep = 1;
-  if (argz > 2) {
-    long v = strtol(argv[2], NULL, 0);
-    if (v > 0 && v < 1000000)
-      nRep = v;
+  bool batchMode = false;
+  bool boundedMode = false;
+  bool fromCharsMode = false;
+  unsigned nThreads = 1;
+  bool perfMode = false;
+  bool latMode = false;
+  enum { ORDER_SHUFFLED, ORDER_ORIGINAL, ORDER_SORTED } order = ORDER_SHUFFLED;
+  enum { PLACE_FILE, PLACE_POOL, PLACE_SCATTER } place = PLACE_FILE;
+  long nCold = 0; // number of conversions in cache-cold test
+  for (int arg_i = 2; arg_i < argz; ++arg_i) {
+    char* arg = argv[arg_i];
+    if (arg[0] == '-') {
+      if (strcmp(arg, "-b")==0) {
+        batchMode = true;
+      } else if (strcmp(arg, "-n")==0) {
+        boundedMode = true;
+      } else if (strcmp(arg, "-f")==0) {
+        boundedMode = fromCharsMode = true;
+      } else if (strcmp(arg, "-perf")==0) {
+        perfMode = true;
+      } else if (strcmp(arg, "-lat")==0) {
+        latMode = true;
+      } else if (strcmp(arg, "-order=shuffled")==0) {
+        order = ORDER_SHUFFLED;
+      } else if (strcmp(arg, "-order=original")==0) {
+        order = ORDER_ORIGINAL;
+      } else if (strcmp(arg, "-order=sorted")==0) {
+        order = ORDER_SORTED;
+      } else if (strcmp(arg, "-place=file")==0) {
+        place = PLACE_FILE;
+      } else if (strcmp(arg, "-place=pool")==0) {
+        place = PLACE_POOL;
+      } else if (strcmp(arg, "-place=scatter")==0) {
+        place = PLACE_SCATTER;
+      } else if (strcmp(arg, "-cold")==0) {
+        nCold = 10000;
+      } else if (strncmp(arg, "-cold=", 6)==0) {
+        long v = strtol(arg+6, NULL, 0);
+        if (v < 1 || v > 100000000) {
+          fprintf(stderr, "Bad option '%s'. Please specify number of conversions in range [1:100000000].\n", arg);
+          return 1;
+        }
+        nCold = v;
+      } else if (strcmp(arg, "-j")==0) {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+      } else if (strncmp(arg, "-j=", 3)==0) {
+        long v = strtol(arg+3, NULL, 0);
+        if (v < 1 || v > 1024) {
+          fprintf(stderr, "Bad option '%s'. Please specify number of threads in range [1:1024].\n", arg);
+          return 1;
+        }
+        nThreads = v;
+      } else {
+        fprintf(stderr, "Unknown option '%s'.\n", arg);
+        return 1;
+      }
+    } else {
+      long v = strtol(arg, NULL, 0);
+      if (v > 0 && v < 1000000)
+        nRep = v;
+    }
   }
 
-  FILE* fp = fopen(argv[1], "r");
-  if (!fp) {
-    perror(argv[1]);
+  if (batchMode && boundedMode) {
+    fprintf(stderr, "Option -b is mutually exclusive with -n and -f.\n");
     return 1;
   }
 
-  // read input
-  std::vector<char*> inpv;
-  char buf[4096];
-  int roundingMode = FE_TONEAREST;
-  while (fgets(buf, sizeof(buf), fp)) {
-    size_t len = strlen(buf);
-    if (len > 17) {
-      char* p = new char[len+1];
-      memcpy(p, buf, len+1);
-      inpv.push_back(p);
-    } else if (inpv.empty() && len > 0) {
-      // first short line could contain control information
-      switch (buf[0]) {
-        case 'd':
-        case 'D':
-          roundingMode = FE_DOWNWARD;
-          break;
-
-        case 'u':
-        case 'U':
-          roundingMode = FE_UPWARD;
-          break;
-
-        case 'n':
-        case 'N':
-          roundingMode = FE_TONEAREST;
-          break;
-
-        case 'z':
-        case 'Z':
-          roundingMode = FE_TOWARDZERO;
-          break;
-
-        default:
-          break;
-      }
-    }
+  test_vector_t tv;
+  if (!loadTestVector(argv[1], &tv))
+    return 1;
+  const uint64_t*     expected = tv.expected;
+  const int8_t*       ties     = tv.ties;
+  std::vector<char*>& srcv     = tv.srcv;
+  std::vector<char*>& srcEnd   = tv.srcEnd;
+  const int  roundingMode = tv.roundingMode;
+  const bool f32 = tv.f32; // test vector of binary32 results, tests strtof()
+  const size_t nItems = srcv.size();
+
+  if (f32 && (batchMode || boundedMode)) {
+    fprintf(stderr, "%s: options -b, -n and -f are not supported for binary32 test vectors.\n", argv[1]);
+    return 1;
+  }
+
+  if (fromCharsMode && roundingMode != FE_TONEAREST) {
+    fprintf(stderr, "%s: from_chars() supports only rounding to nearest.\n", argv[1]);
+    return 1;
+  }
+
+  if (boundedMode) {
+    // Strings end before '\n'. '\n' is replaced by digit, so conversion that reads beyond the end
+    // produces wrong result
+    for (size_t k = 0; k < nItems; ++k)
+      *srcEnd[k] = '7';
   }
-  fclose(fp);
 
   // correctness test
-  int nErrors = 0;
-  int nTiesBrokenToOdd = 0;
-  for (auto it = inpv.begin(); it != inpv.end(); ++it) {
-    char* str = *it;
-    int dTie = 0;
-    switch (*str) {
-      case '+': dTie = -1; ++str; break;
-      case '-': dTie = +1; ++str; break;
-      default: break;
+  std::vector<const char*> batchInp;
+  std::vector<double> batchRes;
+  std::vector<char*>  batchEnd;
+  if (batchMode) {
+    batchInp.assign(srcv.begin(), srcv.end());
+    batchRes.resize(nItems);
+    batchEnd.resize(nItems);
+  }
+
+  // "Test fail at #k" followed by the line of test vector in text format
+  auto failureHeader = [&](size_t k) -> std::string {
+    char hdr[64];
+    snprintf(hdr, sizeof(hdr), "Test fail at #%zu\n%s%016" PRIx64
+      , k, ties[k] > 0 ? "+" : ties[k] < 0 ? "-" : "", expected[k]);
+    return std::string(hdr) + std::string(srcv[k], srcEnd[k] - srcv[k]) + "\n";
+  };
+
+  // test items [first:last). Rounding mode is per-thread, so set by the function itself
+  auto checkRange = [&](size_t first, size_t last, check_result_t* res) {
+    if (batchMode) {
+      // convert all inputs of the range with a single call
+      fesetround(roundingMode);
+      uut_strtod_batch(&batchInp[first], &batchRes[first], &batchEnd[first], last - first);
+      fesetround(FE_TONEAREST);
     }
-    uint64_t u = strtoull(&str[0], NULL, 16);
-    fesetround(roundingMode);
-    char* endp;
-    double d   = uut_strtod(&str[16], &endp);
-    fesetround(FE_TONEAREST);
-    if (endp==&str[16] || d2u(d) != u) {
-      if (roundingMode==FE_TONEAREST && endp != &str[16] && d2u(d) == u+dTie) {
-        // not an error, just tie broken to odd
-        ++nTiesBrokenToOdd;
+    char msg[256];
+    for (size_t k = first; k != last; ++k) {
+      char* src = srcv[k];
+      uint64_t u = expected[k];
+      char* endp;
+      double d;
+      if (f32) {
+        fesetround(roundingMode);
+        float f = uut_strtof(src, &endp);
+        fesetround(FE_TONEAREST);
+        if (endp==src || f2u(f) != u) {
+          if (endp != src && tv.isTieBrokenToOdd(k, f2u(f))) {
+            ++res->nTiesBrokenToOdd;
+          } else {
+            if (res->nErrors < MAX_REPORTED_ERRORS) {
+              snprintf(msg, sizeof(msg),
+              "%08" PRIx64 " %.9e %.9e %08" PRIx64 "\n"
+              , u
+              , u2f(u)
+              , f
+              , f2u(f)
+              );
+              res->failures.push_back(failureHeader(k) + msg);
+            }
+            ++res->nErrors;
+          }
+        }
+        continue;
+      }
+      if (batchMode) {
+        d    = batchRes[k];
+        endp = batchEnd[k];
+      } else if (boundedMode) {
+        const char* first = src;
+        if (fromCharsMode)
+          while (*first == ' ') ++first; // from_chars() does not skip leading whitespace
+        fesetround(roundingMode);
+        d = fromCharsMode ?
+          uut_from_chars(first, srcEnd[k], &endp) :
+          uut_strtod_n  (first, srcEnd[k], &endp);
+        fesetround(FE_TONEAREST);
+        if (endp != srcEnd[k])
+          endp = src; // not a whole string converted, report as failure
       } else {
-        if (nErrors < 1000)
-          fprintf(stderr,
-          "Test fail at #%zu\n%s"
-          "%016" PRIx64 " %.17e %.17e %016" PRIx64 "\n"
-          , it-inpv.begin()
-          , *it
-          , u
-          , u2d(u)
-          , d
-          , d2u(d)
-          );
-        ++nErrors;
+        fesetround(roundingMode);
+        d = uut_strtod(src, &endp);
+        fesetround(FE_TONEAREST);
+      }
+      if (endp==src || d2u(d) != u) {
+        if (endp != src && tv.isTieBrokenToOdd(k, d2u(d))) {
+          // not an error, just tie broken to odd
+          ++res->nTiesBrokenToOdd;
+        } else {
+          if (res->nErrors < MAX_REPORTED_ERRORS) {
+            snprintf(msg, sizeof(msg),
+            "%016" PRIx64 " %.17e %.17e %016" PRIx64 "\n"
+            , u
+            , u2d(u)
+            , d
+            , d2u(d)
+            );
+            res->failures.push_back(failureHeader(k) + msg);
+          }
+          ++res->nErrors;
+        }
       }
     }
+  };
+
+  // split test vector into nThreads contiguous shards
+  nThreads = (unsigned)std::max(std::min(size_t(nThreads), nItems), size_t(1));
+  std::vector<check_result_t> shardRes(nThreads);
+  if (nThreads == 1) {
+    checkRange(0, nItems, &shardRes[0]);
+  } else {
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < nThreads; ++i)
+      workers.push_back(std::thread(checkRange, nItems*i/nThreads, nItems*(i+1)/nThreads, &shardRes[i]));
+    for (auto& w : workers)
+      w.join();
+  }
+
+  // merge results of shards in order
+  int nErrors = 0;
+  int nTiesBrokenToOdd = 0;
+  int nReported = 0;
+  for (auto& r : shardRes) {
+    for (auto it = r.failures.begin(); it != r.failures.end() && nReported < MAX_REPORTED_ERRORS; ++it, ++nReported)
+      fputs(it->c_str(), stderr);
+    nErrors          += r.nErrors;
+    nTiesBrokenToOdd += r.nTiesBrokenToOdd;
   }
   if (nErrors > 0) {
     printf("%d errors\n", nErrors);
@@ -137,40 +446,236 @@ int main(int argz, char** argv)
   printf("\n");
   fflush(stdout);
 
-  // prepare plan of timing test;
-  size_t inplen = inpv.size();
-  std::vector<char*> rndinp(inplen*nRep);
-  for (size_t k = 0; k < inplen; ++k) {
-    char* p = &inpv.data()[k][0];
-    switch (*p) {
-      case '+':
-      case '-':
-        ++p;
-      break;
-      default: break;
+  // prepare plan of timing test: indices of items in order of conversion
+  size_t inplen = nItems;
+  std::vector<uint32_t> plan(inplen*nRep);
+  if (order == ORDER_SHUFFLED) {
+    for (size_t k = 0; k < inplen; ++k)
+      for (long i = 0; i < nRep; ++i)
+        plan[k*nRep+i] = uint32_t(k);
+    std::mt19937_64 gen;
+    gen.seed(1);
+    std::shuffle(plan.begin(), plan.end(), gen);
+  } else {
+    // nRep passes over items in the same order
+    std::vector<uint32_t> items(inplen);
+    for (size_t k = 0; k < inplen; ++k)
+      items[k] = uint32_t(k);
+    if (order == ORDER_SORTED) {
+      std::vector<std::pair<int, long>> keys(inplen);
+      for (size_t k = 0; k < inplen; ++k)
+        orderKey(srcv[k], &keys[k].first, &keys[k].second);
+      std::stable_sort(items.begin(), items.end(),
+        [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
     }
-    p += 16;
     for (long i = 0; i < nRep; ++i)
-      rndinp[k*nRep+i] = p;
+      std::copy(items.begin(), items.end(), &plan[i*inplen]);
+  }
+
+  // placement of strings. Each string is copied together with the character that follows it
+  std::vector<char*> inp(srcv), inpEnd(srcEnd);
+  std::vector<char> placeBuf;
+  if (place != PLACE_FILE) {
+    const size_t CACHE_LINE = 64;
+    size_t slotSize = 0, poolSize = 0;
+    for (size_t k = 0; k < inplen; ++k) {
+      size_t len = srcEnd[k] - srcv[k] + 1;
+      slotSize = std::max(slotSize, len);
+      poolSize += len;
+    }
+    slotSize = (slotSize + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    std::vector<size_t> offsets(inplen);
+    if (place == PLACE_POOL) {
+      // strings in order of the first use
+      std::vector<uint32_t> firstUse;
+      std::vector<bool> used(inplen);
+      for (size_t k = 0; k < plan.size() && firstUse.size() < inplen; ++k) {
+        if (!used[plan[k]]) {
+          used[plan[k]] = true;
+          firstUse.push_back(plan[k]);
+        }
+      }
+      size_t pos = 0;
+      for (uint32_t k : firstUse) {
+        offsets[k] = pos;
+        pos += srcEnd[k] - srcv[k] + 1;
+      }
+    } else {
+      // every string in its own slot, slots in random order, so neighbors in plan are not neighbors in memory
+      std::vector<size_t> slots(inplen);
+      for (size_t k = 0; k < inplen; ++k)
+        slots[k] = k;
+      std::mt19937_64 gen;
+      gen.seed(2);
+      std::shuffle(slots.begin(), slots.end(), gen);
+      for (size_t k = 0; k < inplen; ++k)
+        offsets[k] = slots[k]*slotSize;
+      poolSize = inplen*slotSize;
+    }
+    placeBuf.resize(poolSize + CACHE_LINE);
+    char* pool = &placeBuf[(CACHE_LINE - uintptr_t(placeBuf.data()) % CACHE_LINE) % CACHE_LINE];
+    for (size_t k = 0; k < inplen; ++k) {
+      size_t len = srcEnd[k] - srcv[k] + 1;
+      memcpy(&pool[offsets[k]], srcv[k], len);
+      inp[k]    = &pool[offsets[k]];
+      inpEnd[k] = &pool[offsets[k] + len - 1];
+    }
+  }
+  if (fromCharsMode) {
+    for (size_t k = 0; k < inplen; ++k)
+      while (*inp[k] == ' ') ++inp[k];
+  }
+
+  std::vector<char*> rndinp(inplen*nRep);
+  for (size_t k = 0; k < inplen*nRep; ++k)
+    rndinp[k] = inp[plan[k]];
+  std::vector<char*> rndend;
+  if (boundedMode) {
+    rndend.resize(inplen*nRep);
+    for (size_t k = 0; k < inplen*nRep; ++k)
+      rndend[k] = inpEnd[plan[k]];
   }
-  std::mt19937_64 gen;
-  gen.seed(1);
-  std::shuffle(rndinp.begin(), rndinp.end(), gen);
+  plan.clear();
+  plan.shrink_to_fit();
 
+  perf_counters_t perf;
+  if (perfMode)
+    perf.open();
+
+#ifdef MY_STRTOD_STATS
+  my_strtod_stats_reset();
+#endif
   fesetround(roundingMode);
+  perf.start();
   auto t0 = std::chrono::steady_clock::now();
   uint64_t dummy = 0;
-  for (size_t k = 0; k < inplen*nRep; ++k)
-    dummy += d2u(uut_strtod(rndinp[k], NULL));
+  if (f32) {
+    for (size_t k = 0; k < inplen*nRep; ++k)
+      dummy += f2u(uut_strtof(rndinp[k], NULL));
+  } else if (fromCharsMode) {
+    for (size_t k = 0; k < inplen*nRep; ++k)
+      dummy += d2u(uut_from_chars(rndinp[k], rndend[k], NULL));
+  } else if (boundedMode) {
+    for (size_t k = 0; k < inplen*nRep; ++k)
+      dummy += d2u(uut_strtod_n(rndinp[k], rndend[k], NULL));
+  } else {
+    for (size_t k = 0; k < inplen*nRep; ++k)
+      dummy += d2u(uut_strtod(rndinp[k], NULL));
+  }
   auto t1 = std::chrono::steady_clock::now();
+  perf.stop();
   fesetround(FE_TONEAREST);
   auto dt = t1 - t0;
-
-  for (auto it = inpv.begin(); it != inpv.end(); ++it)
-    delete [] *it;
-
   auto nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(dt);
   printf("%.3f msec. %.2f nsec/iter\n", nsec.count()*1e-6, double(nsec.count())/(inplen*nRep));
+  if (perfMode)
+    perf.print("", double(inplen*nRep));
+#ifdef MY_STRTOD_STATS
+  printStats();
+#endif
+
+  if (latMode) {
+    // The same plan, but conversions form a dependency chain: source pointer is offset by
+    // result of the previous conversion AND zeroMask. zeroMask is 0, but compiler does not know it,
+    // so CPU can't start the next conversion before the previous one is finished.
+    volatile uint64_t zeroMaskV = 0;
+    const uint64_t zeroMask = zeroMaskV;
+    uint64_t dep = 0;
+    fesetround(roundingMode);
+    perf.start();
+    t0 = std::chrono::steady_clock::now();
+    if (f32) {
+      for (size_t k = 0; k < inplen*nRep; ++k) {
+        uint64_t r = f2u(uut_strtof(rndinp[k] + dep, NULL));
+        dummy += r;
+        dep = r & zeroMask;
+      }
+    } else if (fromCharsMode) {
+      for (size_t k = 0; k < inplen*nRep; ++k) {
+        uint64_t r = d2u(uut_from_chars(rndinp[k] + dep, rndend[k] + dep, NULL));
+        dummy += r;
+        dep = r & zeroMask;
+      }
+    } else if (boundedMode) {
+      for (size_t k = 0; k < inplen*nRep; ++k) {
+        uint64_t r = d2u(uut_strtod_n(rndinp[k] + dep, rndend[k] + dep, NULL));
+        dummy += r;
+        dep = r & zeroMask;
+      }
+    } else {
+      for (size_t k = 0; k < inplen*nRep; ++k) {
+        uint64_t r = d2u(uut_strtod(rndinp[k] + dep, NULL));
+        dummy += r;
+        dep = r & zeroMask;
+      }
+    }
+    t1 = std::chrono::steady_clock::now();
+    perf.stop();
+    fesetround(FE_TONEAREST);
+    nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+    printf("latency: %.3f msec. %.2f nsec/iter\n", nsec.count()*1e-6, double(nsec.count())/(inplen*nRep));
+    if (perfMode)
+      perf.print("latency: ", double(inplen*nRep));
+  }
+
+  if (batchMode) {
+    // convert the same plan by chunks of BATCH_CHUNK strings
+    const size_t BATCH_CHUNK = 1024;
+    double batchBuf[BATCH_CHUNK];
+    fesetround(roundingMode);
+    perf.start();
+    t0 = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < inplen*nRep; k += BATCH_CHUNK) {
+      size_t len = std::min(BATCH_CHUNK, inplen*nRep - k);
+      uut_strtod_batch(&rndinp[k], batchBuf, NULL, len);
+      for (size_t i = 0; i < len; ++i)
+        dummy += d2u(batchBuf[i]);
+    }
+    t1 = std::chrono::steady_clock::now();
+    perf.stop();
+    fesetround(FE_TONEAREST);
+    nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+    printf("batch: %.3f msec. %.2f nsec/iter\n", nsec.count()*1e-6, double(nsec.count())/(inplen*nRep));
+    if (perfMode)
+      perf.print("batch: ", double(inplen*nRep));
+  }
+
+  if (nCold > 0) {
+    // Single conversions of the plan, each preceded by reading of buffer that is bigger than L2 cache
+    // of most CPUs, so inputs, tables and code of conversion come from LLC or memory.
+    // Only conversion is timed. The cost of empty timed interval, after the same eviction, is subtracted.
+    const size_t COLD_EVICT_BYTES = size_t(8) << 20;
+    std::vector<uint64_t> evictBuf(COLD_EVICT_BYTES/sizeof(uint64_t), 1);
+    size_t n = std::min(size_t(nCold), inplen*nRep);
+    auto convertOne = [&](size_t k) -> uint64_t {
+      if (f32)
+        return f2u(uut_strtof(rndinp[k], NULL));
+      if (fromCharsMode)
+        return d2u(uut_from_chars(rndinp[k], rndend[k], NULL));
+      if (boundedMode)
+        return d2u(uut_strtod_n(rndinp[k], rndend[k], NULL));
+      return d2u(uut_strtod(rndinp[k], NULL));
+    };
+    std::chrono::steady_clock::duration tConv(0), tEmpty(0);
+    fesetround(roundingMode);
+    for (size_t k = 0; k < n; ++k) {
+      dummy += evictCaches(evictBuf);
+      t0 = std::chrono::steady_clock::now();
+      dummy += convertOne(k);
+      t1 = std::chrono::steady_clock::now();
+      tConv += t1 - t0;
+      dummy += evictCaches(evictBuf);
+      t0 = std::chrono::steady_clock::now();
+      t1 = std::chrono::steady_clock::now();
+      tEmpty += t1 - t0;
+    }
+    fesetround(FE_TONEAREST);
+    double nsecConv  = double(std::chrono::duration_cast<std::chrono::nanoseconds>(tConv).count());
+    double nsecEmpty = double(std::chrono::duration_cast<std::chrono::nanoseconds>(tEmpty).count());
+    printf("cold: %.2f nsec/iter (%zu conversions, %zu MB read before each, %.2f nsec of timer subtracted)\n",
+      (nsecConv - nsecEmpty)/n, n, COLD_EVICT_BYTES >> 20, nsecEmpty/n);
+  }
+
   return dummy==42? 42 :0;
 }
 
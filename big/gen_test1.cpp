@@ -6,13 +6,16 @@
 #include <cfloat>
 #include <random>
 
+#include "test_vector_bin.h"
+
 static const char UsageStr[] =
 "gen_test1 - generate test vector consisting of canonical 17-digit\n"
 "            representations of finite IEEE-754 binary64 numbers\n"
 "Usage:\n"
-"gen_test1 [?] [-?] [count]\n"
+"gen_test1 [?] [-?] [count] [-bin=file]\n"
 "where\n"
 "count - [optional] number of items to generate. Range [1:100000000]. Default 100000.\n"
+"-bin=file - [optional] in addition to the text on stdout write binary container of test vector to file\n"
 "-?, ? - show this message"
 ;
 
@@ -41,20 +44,32 @@ static double u2d(uint64_t x) {
 int main(int argz, char** argv)
 {
   long len = 100000;
-  if (argz > 1) {
-    if (strcmp(argv[1], "?")==0 || strcmp(argv[1], "-?")==0) {
+  const char* binName = NULL;
+  bool gotCount = false;
+  for (int arg_i = 1; arg_i < argz; ++arg_i) {
+    char* arg = argv[arg_i];
+    if (strcmp(arg, "?")==0 || strcmp(arg, "-?")==0) {
       fprintf(stderr, "%s", UsageStr);
       return 0;
     }
-    long v = strtol(argv[1], NULL, 0);
-    if (v > 0 && v <= 100000000) {
+    if (strncmp(arg, "-bin=", 5)==0 && arg[5] != 0) {
+      binName = &arg[5];
+      continue;
+    }
+    long v = strtol(arg, NULL, 0);
+    if (!gotCount && v > 0 && v <= 100000000) {
       len = v;
+      gotCount = true;
     } else {
-      fprintf(stderr, "Illegal count '%s'.\n%s", argv[1], UsageStr);
+      fprintf(stderr, "Illegal parameter '%s'.\n%s", arg, UsageStr);
       return 1;
     }
   }
 
+  tvbin_writer_t bin;
+  if (binName && !bin.open(binName, 'n', false))
+    return 1;
+
   std::mt19937_64 gen;
   gen.seed(1);
 
@@ -65,8 +80,14 @@ int main(int argz, char** argv)
     uint64_t urnd = gen();
     uint64_t ufin = mulu(urnd*2, RSCALE) | (urnd & BIT63); // transform to finite range
     double d = u2d(ufin);
-    printf("%016" PRIx64 " %.17e\n", ufin, d);
+    char line[64];
+    snprintf(line, sizeof(line), "%016" PRIx64 " %.17e\n", ufin, d);
+    fputs(line, stdout);
+    if (binName && !bin.addLine(line))
+      return 1;
   }
+  if (binName && !bin.close())
+    return 1;
   return 0;
 }
 
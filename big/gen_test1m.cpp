@@ -6,17 +6,20 @@
 #include <cfloat>
 #include <random>
 
+#include "test_vector_bin.h"
+
 static const char UsageStr[] =
 "gen_test1m - generate test vector consisting of canonical 17-digit\n"
 "             representations of finite IEEE-754 binary64 numbers\n"
 "Usage:\n"
-"gen_test1 [-c=count] [-fmin=nnn] [-fmax=xxx] [-s=seed] [-h] [-?] [?]\n"
+"gen_test1 [-c=count] [-fmin=nnn] [-fmax=xxx] [-s=seed] [-h] [-bin=file] [-?] [?]\n"
 "where\n"
 "count - [optional] number of items to generate. Default=100000\n"
 "nnn   - [optional] lower edge of the range of absolute values of generated number. Default=0\n"
 "xxx   - [optional] upper edge of the range of absolute values of generated number. Default=DBL_MAX\n"
 "seed  - [optional] PRNG seed. Default=1\n"
 "-h    - output in hexadecimal floating-point format\n"
+"file  - [optional] in addition to the text on stdout write binary container of test vector to file\n"
 "-?, ? - show this message"
 ;
 
@@ -49,6 +52,7 @@ int main(int argz, char** argv)
   double fMax = DBL_MAX;
   int  seed = 1;
   bool hexOutput = false;
+  const char* binName = NULL;
   for (int arg_i = 1; arg_i < argz; ++arg_i) {
     char* arg = argv[arg_i];
     if (strcmp(arg, "?")==0) {
@@ -82,8 +86,8 @@ int main(int argz, char** argv)
         return 1;
       }
 
-      enum { O_C, O_FMIN, O_FMAX, O_S, O_UNK };
-      static const char *optstr[] = { "c", "fmin", "fmax", "s" };
+      enum { O_C, O_FMIN, O_FMAX, O_S, O_BIN, O_UNK };
+      static const char *optstr[] = { "c", "fmin", "fmax", "s", "bin" };
       int op = 0;
       for (op = 0; op < O_UNK; ++op) {
         if (0==strncmp(&arg[1], optstr[op], eq-arg-1))
@@ -142,6 +146,14 @@ int main(int argz, char** argv)
           }
         } break;
 
+        case O_BIN:
+          if (eq[1] == 0) {
+            fprintf(stderr, "Bad option '%s'. Please specify file name.\n", arg);
+            return 1;
+          }
+          binName = eq+1;
+          break;
+
         default:
           fprintf(stderr, "Unknown option '%s'.\n", arg);
           return 1;
@@ -149,6 +161,10 @@ int main(int argz, char** argv)
     }
   }
 
+  tvbin_writer_t bin;
+  if (binName && !bin.open(binName, 'n', false))
+    return 1;
+
   std::mt19937_64 gen;
   gen.seed(seed);
 
@@ -161,11 +177,17 @@ int main(int argz, char** argv)
     uint64_t urnd = gen();
     uint64_t ufin = (mulu(urnd*2, RSCALE) + uMin) | (urnd & BIT63); // transform to finite range
     double d = u2d(ufin);
+    char line[64];
     if (!hexOutput)
-      printf("%016" PRIx64 " %.17e\n", ufin, d);
+      snprintf(line, sizeof(line), "%016" PRIx64 " %.17e\n", ufin, d);
     else
-      printf("%016" PRIx64 " %a\n", ufin, d);
+      snprintf(line, sizeof(line), "%016" PRIx64 " %a\n", ufin, d);
+    fputs(line, stdout);
+    if (binName && !bin.addLine(line))
+      return 1;
   }
+  if (binName && !bin.close())
+    return 1;
   return 0;
 }
 
@@ -6,22 +6,34 @@
 #include <cfloat>
 #include <cfenv>
 #include <random>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
 
 #include <gmp.h>
 
+#include "test_vector_bin.h"
+#include "worker_pool.h"
+
 static const char UsageStr[] =
 "gen_test2 - generate test vector with specified number of significant digits\n"
 "Usage:\n"
-"gen_test2 nDigits [-c=count] [-emin=nnn] [-emax=xxx] [-z] [-d] [-u] [-s=seed] [?] [-?]\n"
+"gen_test2 nDigits [-c=count] [-emin=nnn] [-emax=xxx] [-z] [-d] [-u] [-f] [-i] [-s=seed] [-j[=nThreads]] [-bin=file] [?] [-?]\n"
 "where\n"
 "nDigits - number of significant decimal digits\n"
 "count   - [optional] number of items to generate. Range [1:100000000]. Default 100000.\n"
-"nnn     - [optional] lower edge of the range of decimal exponents. Default=-325\n"
+"nnn     - [optional] lower edge of the range of decimal exponents. Default=-325, for binary32 -47\n"
 "-z      - specify non-default rounding mode: rounding towards zero\n"
 "-d      - specify non-default rounding mode: rounding down (towards negative infinity)\n"
 "-u      - specify non-default rounding mode: rounding up (towards positive infinity)\n"
-"xxx     - [optional] upper edge of the range of decimal exponents. Default=+325\n"
+"-f      - generate binary32 rather than binary64 test vector\n"
+"-i      - generate integers of up to nDigits digits, without decimal point and exponent. nnn and xxx are ignored\n"
+"xxx     - [optional] upper edge of the range of decimal exponents. Default=+325, for binary32 +40\n"
 "seed    - [optional] PRNG seed. Default=1\n"
+"-j      - [optional] generate in nThreads threads. Default - number of hardware threads.\n"
+"          Output does not depend on nThreads\n"
+"file    - [optional] in addition to the text on stdout write binary container of test vector to file\n"
 "-?, ?   - show this message"
 ;
 
@@ -30,6 +42,8 @@ enum {
   N_DIGITS_MAX =  800,
   DECEXP_MIN   = -325, // from 0.1e-322
   DECEXP_MAX   =  325, // to   1.0e308
+  DECEXP_MIN_F32 = -47, // from 0.1e-46
+  DECEXP_MAX_F32 =  40, // to   1.0e39
 
   POW10_TAB_LEN = N_DIGITS_MAX-DECEXP_MIN+2,
 };
@@ -44,13 +58,39 @@ static uint64_t d2u(double x) {
   return y;
 }
 
-static double u2d(uint64_t x) {
-  double y;
+static uint32_t f2u(float x) {
+  uint32_t y;
   memcpy(&y, &x, sizeof(y));
   return y;
 }
 
-static int body(int nDigits, long nItems, int  decexpMin, int  decexpMax, int seed, int  roundingMode);
+// parameters of binary floating-point format
+struct fp_format_t {
+  int    mntBits;         // significand bits, including implied '1'
+  int    maxExp;          // numbers >= 2**maxExp are not representable
+  int    subnormalExp;    // ULP of subnormal numbers is 2**(-subnormalExp)
+  int    decexpOverflow;  // decimal exponent, above which overflow is possible
+  int    decexpUnderflow; // decimal exponent, at or below which underflow is certain
+  double maxVal;          // biggest finite number
+  double minVal;          // smallest subnormal number
+  mpz_t  zMax;            // = maxVal
+  mpz_t  zMaxLimit;       // = maxVal + 0.5 ULP
+};
+
+static fp_format_t fmt64 = { 53, 1024, 1074, 308, -324, DBL_MAX, 4.9406564584124654e-324 };
+static fp_format_t fmt32 = { 24,  128,  149,  38,  -46, FLT_MAX, 1.40129846e-45 };
+
+// next representable number of format fmt above x
+static double nextUp(const fp_format_t& fmt, double x) {
+  return fmt.mntBits == 24 ? nextafterf(float(x), FLT_MAX) : nextafter(x, DBL_MAX);
+}
+
+// the LS bit of significand of x is set
+static bool isOdd(const fp_format_t& fmt, double x) {
+  return fmt.mntBits == 24 ? (f2u(float(x)) & 1) : (d2u(x) & 1);
+}
+
+static int body(int nDigits, long nItems, int  decexpMin, int  decexpMax, int seed, int  roundingMode, const fp_format_t& fmt, bool integers, unsigned nThreads, tvbin_writer_t* bin);
 static void MakeTables();
 
 int main(int argz, char** argv)
@@ -82,6 +122,12 @@ int main(int argz, char** argv)
   int  decexpMax = DECEXP_MAX;
   int  seed = 1;
   int  roundingModeChar = 'n';
+  bool binary32 = false;
+  bool integers = false;
+  bool decexpMinSet = false;
+  bool decexpMaxSet = false;
+  unsigned nThreads = 1;
+  const char* binName = NULL;
   for (int arg_i = 2; arg_i < argz; ++arg_i) {
     char* arg = argv[arg_i];
     if (strcmp(arg, "?")==0 || strcmp(arg, "-?")==0) {
@@ -105,6 +151,18 @@ int main(int argz, char** argv)
         case 'z':
           roundingModeChar = arg[1];
           break;
+        case 'F':
+        case 'f':
+          binary32 = true;
+          break;
+        case 'I':
+        case 'i':
+          integers = true;
+          break;
+        case 'J':
+        case 'j':
+          nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+          break;
         default:
           fprintf(stderr, "Unknown option flag '%s'\n", arg);
           return 1;
@@ -116,6 +174,15 @@ int main(int argz, char** argv)
         return 1;
       }
 
+      if (eq > &arg[1] && 0==strncmp(&arg[1], "bin", eq-arg-1)) {
+        if (eq[1] == 0) {
+          fprintf(stderr, "Bad option '%s'. Please specify file name.\n", arg);
+          return 1;
+        }
+        binName = eq+1;
+        continue;
+      }
+
       char* endp;
       long v = strtol(eq+1, &endp, 0);
       if (endp==eq+1) {
@@ -135,14 +202,22 @@ int main(int argz, char** argv)
           return 1;
         }
         decexpMin = v;
+        decexpMinSet = true;
       } else if (0==strncmp(&arg[1], "emax", eq-arg-1)) {
         if (v < decexpMin || v > DECEXP_MAX) {
           fprintf(stderr, "Bad option '%s'. Please specify number in range [%d:%d].\n", arg, decexpMin, DECEXP_MAX);
           return 1;
         }
         decexpMax = v;
+        decexpMaxSet = true;
       } else if (0==strncmp(&arg[1], "s", eq-arg-1)) {
         seed = v;
+      } else if (0==strncmp(&arg[1], "j", eq-arg-1)) {
+        if (v < 1 || v > 1024) {
+          fprintf(stderr, "Bad option '%s'. Please specify number of threads in range [1:1024].\n", arg);
+          return 1;
+        }
+        nThreads = v;
       } else {
         fprintf(stderr, "Unknown option '%s'.\n", arg);
         return 1;
@@ -150,10 +225,18 @@ int main(int argz, char** argv)
     }
   }
 
+  if (binary32) {
+    // narrow default range of decimal exponents
+    if (!decexpMinSet)
+      decexpMin = decexpMaxSet && decexpMax < DECEXP_MIN_F32 ? decexpMax : DECEXP_MIN_F32;
+    if (!decexpMaxSet)
+      decexpMax = decexpMin > DECEXP_MAX_F32 ? decexpMin : DECEXP_MAX_F32;
+  }
+
   int roundingMode = FE_TONEAREST;
-  if (roundingModeChar != 'n') {
-    // non-default rounding mode
-    printf("%c\n", roundingModeChar);
+  if (roundingModeChar != 'n' || binary32) {
+    // non-default rounding mode or format
+    printf("%c%s\n", roundingModeChar, binary32 ? "f" : "");
     switch (roundingModeChar) {
       case 'D':
       case 'd':
@@ -175,8 +258,15 @@ int main(int argz, char** argv)
     }
   }
 
+  tvbin_writer_t bin;
+  if (binName && !bin.open(binName, roundingModeChar, binary32))
+    return 1;
+
   MakeTables();
-  return body(nDigits, nItems, decexpMin, decexpMax, seed, roundingMode);
+  int ret = body(nDigits, nItems, decexpMin, decexpMax, seed, roundingMode, binary32 ? fmt32 : fmt64, integers, nThreads, binName ? &bin : NULL);
+  if (ret == 0 && binName && !bin.close())
+    return 1;
+  return ret;
 }
 
 static mpz_t  pow10_tab_z[POW10_TAB_LEN];
@@ -187,8 +277,6 @@ static const unsigned pow10_tab_u[] = {
     1000*1000, 10*1000*1000, 100*1000*1000,
     1000*1000*1000,
 };
-static mpz_t dblMax;
-static mpz_t dblMaxLimit;
 
 static void MakeTables()
 {
@@ -207,13 +295,17 @@ static void MakeTables()
     pow10i_tab_d[i] = ldexp(mpz_get_d(x), -100);
   }
 
-  mpz_init_set_d(dblMax, DBL_MAX);
+  fp_format_t* formats[] = { &fmt64, &fmt32 };
+  for (fp_format_t* fmt : formats) {
+    mpz_init_set_d(fmt->zMax, fmt->maxVal);
 
-  // set dblMaxLimit to DBL_MAX + 0.5 ULP(DBL_MAX)
-  mpz_init_set_si(dblMaxLimit, 1);
-  mpz_mul_2exp(dblMaxLimit, dblMaxLimit, 54);      // = 2**54
-  mpz_sub_ui  (dblMaxLimit, dblMaxLimit, 1);       // = 2**54-1
-  mpz_mul_2exp(dblMaxLimit, dblMaxLimit, 1024-54); // = ((2**54-1)/2**54)*2**1024
+    // set zMaxLimit to maxVal + 0.5 ULP(maxVal)
+    int n = fmt->mntBits + 1;
+    mpz_init_set_si(fmt->zMaxLimit, 1);
+    mpz_mul_2exp(fmt->zMaxLimit, fmt->zMaxLimit, n);             // = 2**n
+    mpz_sub_ui  (fmt->zMaxLimit, fmt->zMaxLimit, 1);             // = 2**n-1
+    mpz_mul_2exp(fmt->zMaxLimit, fmt->zMaxLimit, fmt->maxExp-n); // = ((2**n-1)/2**n)*2**maxExp
+  }
 }
 
 static int core_cmp(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int decpow, double d, int dScale, bool inc)
@@ -243,7 +335,8 @@ struct calc_d_res_t {
   calc_d_res_t(double x, const char* str) { d = x; tieStr=str; }
 };
 
-static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int decexp, const unsigned mntDigits[], int  roundingMode)
+// Comments use figures of binary64. For binary32 they are 128 instead of 1024, 149 instead of 1074 etc.
+static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int decexp, const unsigned mntDigits[], int  roundingMode, const fp_format_t& fmt)
 {
   // calculate mantissa
   int fullNd = (nDigits-1)/9;
@@ -259,8 +352,8 @@ static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int d
   if (mpz_cmp_ui(x, 0)==0)
     return calc_d_res_t(0);
 
-  if (decexp <= -324)
-    return calc_d_res_t(roundingMode==FE_UPWARD ? u2d(1) : 0);
+  if (decexp <= fmt.decexpUnderflow)
+    return calc_d_res_t(roundingMode==FE_UPWARD ? fmt.minVal : 0);
 
   // scale by power of 10
   int decpow = decexp - nDigits;
@@ -269,20 +362,20 @@ static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int d
     decpow = 0;
   }
 
-  if (decexp > 308) {
+  if (decexp > fmt.decexpOverflow) {
     // test for overflow
-    mpz_mul_2exp(zTmp1, pow10_tab_z[-decpow], 1024); // zTmp1 = 10**(-decpow)*2**1024
+    mpz_mul_2exp(zTmp1, pow10_tab_z[-decpow], fmt.maxExp); // zTmp1 = 10**(-decpow)*2**1024
     if (mpz_cmp(x, zTmp1) >= 0)  // x >= 10**(-decpow)*2**1024 <=> x*10**decpow >= 2**1024
-      return calc_d_res_t(HUGE_VAL);
+      return calc_d_res_t(roundingMode == FE_TOWARDZERO ? fmt.maxVal : HUGE_VAL);
 
     // x*10**decpow < 2**1024
-    if (roundingMode == FE_TONEAREST) { // compare with dblMaxLimit== DBL_MAX+0.5*ULP
+    if (roundingMode == FE_TONEAREST) { // compare with zMaxLimit== DBL_MAX+0.5*ULP
       int cond = 0;
       if (decpow < 0) {
-        mpz_mul(zTmp1, dblMaxLimit, pow10_tab_z[-decpow]);
+        mpz_mul(zTmp1, fmt.zMaxLimit, pow10_tab_z[-decpow]);
         cond = mpz_cmp(x, zTmp1);
       } else {
-        cond = mpz_cmp(x, dblMaxLimit);
+        cond = mpz_cmp(x, fmt.zMaxLimit);
       }
       if (cond >= 0) {
         calc_d_res_t ret(HUGE_VAL); // overflow
@@ -293,13 +386,13 @@ static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int d
     } else if (roundingMode == FE_UPWARD) { // compare with DBL_MAX
       int cond = 0;
       if (decpow < 0) {
-        mpz_mul(zTmp1, dblMax, pow10_tab_z[-decpow]);
+        mpz_mul(zTmp1, fmt.zMax, pow10_tab_z[-decpow]);
         cond = mpz_cmp(x, zTmp1);
       } else {
-        cond = mpz_cmp(x, dblMax);
+        cond = mpz_cmp(x, fmt.zMax);
       }
       if (cond == 0)
-        return calc_d_res_t(DBL_MAX);
+        return calc_d_res_t(fmt.maxVal);
       if (cond > 0)
         return calc_d_res_t(HUGE_VAL);
     }
@@ -307,7 +400,7 @@ static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int d
 
   // test for underflow
   if (roundingMode == FE_TONEAREST) {
-    mpz_mul_2exp(zTmp1, x, 1075);  // zTmp1 = x * 2**1075
+    mpz_mul_2exp(zTmp1, x, fmt.subnormalExp+1);  // zTmp1 = x * 2**1075
     int cond = mpz_cmp(zTmp1, pow10_tab_z[-decpow]);
     if (cond <= 0) { // x * 2**1075 <= 10**(-decpow) <=> x*10**decpow <= 2**-1075
       calc_d_res_t ret(0);
@@ -316,10 +409,10 @@ static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int d
       return ret; // underflow
     }
   } else {
-    mpz_mul_2exp(zTmp1, x, 1074);  // zTmp1 = x * 2**1074
+    mpz_mul_2exp(zTmp1, x, fmt.subnormalExp);  // zTmp1 = x * 2**1074
     int cond = mpz_cmp(zTmp1, pow10_tab_z[-decpow]);
     if (cond <= 0) { // x * 2**1074 <= 10**(-decpow) <=> x*10**decpow <= 2**-1074
-      double dRet = (cond == 0 || roundingMode==FE_UPWARD) ? u2d(1) : 0;
+      double dRet = (cond == 0 || roundingMode==FE_UPWARD) ? fmt.minVal : 0;
       return calc_d_res_t(dRet);
     }
   }
@@ -337,21 +430,28 @@ static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int d
   dMnt = frexp(dMnt, &e2);
   dExp += e2;
 
-  if (dExp < -1073)
-    return calc_d_res_t(4.9406564584124654e-324); // nextafter(0, 1), has to be that, because possibility of underflow already rejected
+  if (dExp < 1-fmt.subnormalExp)
+    return calc_d_res_t(fmt.minVal); // nextafter(0, 1), has to be that, because possibility of underflow already rejected
 
-  if (dExp > 1024)
-    return calc_d_res_t(DBL_MAX);  // has to be that, because possibility of overflow already rejected
+  if (dExp > fmt.maxExp)
+    return calc_d_res_t(fmt.maxVal);  // has to be that, because possibility of overflow already rejected
 
   // dExp in [-1073:1024]
   double d0 = ldexp(dMnt, dExp);
   if (d0 <= DBL_MIN)
     d0 = nextafter(d0, 0); // subnormal can be rounded up. In order to be sure that our estimate is from below, lets reduce it by 1 ulp
+  if (fmt.mntBits == 24) {
+    // truncate estimate to binary32
+    float f0 = float(d0);
+    if (f0 > d0)
+      f0 = nextafterf(f0, 0);
+    d0 = f0;
+  }
   for (;;) {
-    if (d0 == DBL_MAX)
-      return calc_d_res_t(DBL_MAX);  // has to be that, because possibility of overflow already rejected
+    if (d0 == fmt.maxVal)
+      return calc_d_res_t(fmt.maxVal);  // has to be that, because possibility of overflow already rejected
 
-    double d1 = nextafter(d0, DBL_MAX);
+    double d1 = nextUp(fmt, d0);
     int ulpExp;
     frexp(d1-d0, &ulpExp);
     int dScale = 2 - ulpExp; // (d1-d0)* 2**dScale == 2
@@ -384,7 +484,7 @@ static calc_d_res_t calc_d(mpz_t x, mpz_t zTmp1, mpz_t zTmp2, int nDigits, int d
 
     // x*10**decpow == (d0+d1)/2
     // break tie to even
-    if ((d2u(d0) & 1)==0)
+    if (!isOdd(fmt, d0))
       return calc_d_res_t(d0, "-"); // tie broken toward zero
     else
       return calc_d_res_t(d1, "+"); // tie broken away from zero
@@ -407,7 +507,7 @@ static void mntToStr(char* dst, int fullNd, int lastNd, const unsigned mntDigits
   binToDecStr(&dst[fullNd*9], lastNd, mntDigits[fullNd]);
 }
 
-static int body(int nDigits, long nItems, int decexpMin, int  decexpMax, int seed, int roundingMode)
+static int body(int nDigits, long nItems, int decexpMin, int  decexpMax, int seed, int roundingMode, const fp_format_t& fmt, bool integers, unsigned nThreads, tvbin_writer_t* bin)
 {
   int negRoundingMode = roundingMode;
   int posRoundingMode = roundingMode;
@@ -422,33 +522,91 @@ static int body(int nDigits, long nItems, int decexpMin, int  decexpMax, int see
       break;
   }
 
+  // Items are generated by blocks of BLOCK_ITEMS. In each round worker t generates block t of the round.
+  // PRNG outputs of the round are drawn sequentially by the calling thread and handed to the workers,
+  // so item #k is made of the same random numbers as in sequential generation and the output
+  // does not depend on the number of threads. The expensive part, conversion, runs in the workers.
+  const long BLOCK_ITEMS = 4096;
+  const int fullNd = (nDigits-1)/9;
+  const int lastNd = nDigits - fullNd*9;
+  const unsigned rndPerItem = fullNd + 2;
+  struct worker_t {
+    std::vector<uint64_t> rnd; // PRNG outputs for the current block
+    long first, last;          // items of the current block
+    mpz_t zTmp0, zTmp1, zTmp2;
+    std::string out; // lines of the current block, each terminated by '\n' and '\0'
+  };
   std::mt19937_64 gen;
   gen.seed(seed);
+  std::vector<worker_t> workers(nThreads);
+  for (unsigned t = 0; t < nThreads; ++t) {
+    worker_t& w = workers[t];
+    mpz_init(w.zTmp0);
+    mpz_init(w.zTmp1);
+    mpz_init(w.zTmp2);
+  }
 
-  mpz_t zTmp0, zTmp1, zTmp2;
-  mpz_init(zTmp0);
-  mpz_init(zTmp1);
-  mpz_init(zTmp2);
-  int fullNd = (nDigits-1)/9;
-  int lastNd = nDigits - fullNd*9;
-  unsigned mntDigits[N_DIGITS_MAX/9+1];
-  char mntStr[N_DIGITS_MAX + 10];
-  for (long it = 0; it < nItems; ++it) {
-    // generate random integer in range [0:10**nDigits)
-    // 9 digits at time.
-    // I'd like to do more digits, but don't know how to use 'long long' with GMP
-    for (int i = 0; i < fullNd; ++i)
-      mntDigits[i] = mulu(gen(), 1000000000u);            // [0:1e9-1]
-    mntDigits[fullNd] = mulu(gen(), pow10_tab_u[lastNd]); // [0:10**lastNd-1]
-
-    uint64_t urnd = gen();
-    uint64_t sign = urnd >> 63;
-    int decexp = int(mulu(urnd<<1, decexpMax+1-decexpMin)) + decexpMin;
-
-    calc_d_res_t r = calc_d(zTmp0, zTmp1, zTmp2, nDigits, decexp, mntDigits, sign ? negRoundingMode : posRoundingMode);
-    mntToStr(mntStr, fullNd, lastNd, mntDigits);
-
-    printf("%s%016" PRIx64 " %s0.%se%d\n", r.tieStr, d2u(r.d) | (sign << 63), sign ? "-" : "", mntStr, decexp);
+  // generate items [w.first:w.last) of block t
+  auto genBlock = [&](unsigned t) {
+    worker_t* w = &workers[t];
+    const uint64_t* rnd = w->rnd.data();
+    unsigned mntDigits[N_DIGITS_MAX/9+1];
+    char mntStr[N_DIGITS_MAX + 10];
+    char line[N_DIGITS_MAX + 48];
+    w->out.clear();
+    for (long it = w->first; it < w->last; ++it) {
+      // generate random integer in range [0:10**nDigits)
+      // 9 digits at time.
+      // I'd like to do more digits, but don't know how to use 'long long' with GMP
+      for (int i = 0; i < fullNd; ++i)
+        mntDigits[i] = mulu(*rnd++, 1000000000u);            // [0:1e9-1]
+      mntDigits[fullNd] = mulu(*rnd++, pow10_tab_u[lastNd]); // [0:10**lastNd-1]
+
+      uint64_t urnd = *rnd++;
+      uint64_t sign = urnd >> 63;
+      int decexp = integers ? nDigits : int(mulu(urnd<<1, decexpMax+1-decexpMin)) + decexpMin;
+
+      calc_d_res_t r = calc_d(w->zTmp0, w->zTmp1, w->zTmp2, nDigits, decexp, mntDigits, sign ? negRoundingMode : posRoundingMode, fmt);
+      mntToStr(mntStr, fullNd, lastNd, mntDigits);
+
+      uint64_t u = fmt.mntBits == 24 ?
+        f2u(float(r.d)) | (sign << 31) :
+        d2u(r.d)        | (sign << 63);
+      int len;
+      if (integers) {
+        // strip leading zeros, but keep at least one digit
+        const char* intStr = mntStr;
+        while (intStr[0] == '0' && intStr[1] != 0)
+          ++intStr;
+        len = snprintf(line, sizeof(line), "%s%016" PRIx64 " %s%s\n", r.tieStr, u, sign ? "-" : "", intStr);
+      } else {
+        len = snprintf(line, sizeof(line), "%s%016" PRIx64 " %s0.%se%d\n", r.tieStr, u, sign ? "-" : "", mntStr, decexp);
+      }
+      w->out.append(line, len+1);
+    }
+  };
+
+  worker_pool_t pool(nThreads);
+  for (long round = 0; round < nItems; round += BLOCK_ITEMS*nThreads) {
+    unsigned nActive = unsigned(std::min((nItems - round + BLOCK_ITEMS - 1)/BLOCK_ITEMS, long(nThreads)));
+    for (unsigned t = 0; t < nActive; ++t) {
+      worker_t& w = workers[t];
+      w.first = round + BLOCK_ITEMS*t;
+      w.last  = std::min(w.first + BLOCK_ITEMS, nItems);
+      w.rnd.resize((w.last - w.first)*rndPerItem);
+      for (uint64_t& r : w.rnd)
+        r = gen();
+    }
+    pool.run(nActive, genBlock);
+    // output in order
+    for (unsigned t = 0; t < nActive; ++t) {
+      const std::string& out = workers[t].out;
+      for (size_t pos = 0; pos < out.size(); pos += strlen(&out[pos]) + 1) {
+        fputs(&out[pos], stdout);
+        if (bin && !bin->addLine(&out[pos]))
+          return 1;
+      }
+    }
   }
   return 0;
 }
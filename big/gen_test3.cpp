@@ -5,9 +5,16 @@
 #include <cstring>
 #include <cfloat>
 #include <random>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
 
 #include <gmp.h>
 
+#include "test_vector_bin.h"
+#include "worker_pool.h"
+
 static uint64_t mulu(uint64_t x, uint64_t y) {
   return uint64_t(((unsigned __int128)x * y) >> 64);
 }
@@ -18,6 +25,12 @@ static uint64_t d2u(double x) {
   return y;
 }
 
+static uint64_t f2u(float x) {
+  uint32_t y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
 #if 0
 static double u2d(uint64_t x) {
   double y;
@@ -26,22 +39,26 @@ static double u2d(uint64_t x) {
 }
 #endif
 
-static int body(long nItems, double fMin, double fMax, int seed, double dev);
+static int body(long nItems, double fMin, double fMax, int seed, double dev, bool f32, unsigned nThreads, tvbin_writer_t* bin);
 static void MakeTables();
 
 static const char UsageStr[] =
 "gen_test3 - produce test vector consisting of \"evil\" decimal strings\n"
-" exactly at midpoints between representable binary64 numbers or, optionally,\n"
-" close to a midpoint\n"
+" exactly at midpoints between representable binary64 (or binary32) numbers or,\n"
+" optionally, close to a midpoint\n"
 "Usage:\n"
-"gen_test3 [-c=count] [-fmin=nnn] [-fmax=xxx] [-dev=ddd] [-s=seed] [-?] [?]\n"
+"gen_test3 [-c=count] [-fmin=nnn] [-fmax=xxx] [-dev=ddd] [-s=seed] [-f] [-j[=nThreads]] [-bin=file] [-?] [?]\n"
 "where\n"
 "count - [optional] number of items to generate\n"
 "nnn   - [optional] lower edge of the range of absolute values of generated number. Default=0\n"
-"xxx   - [optional] upper edge of the range of absolute values of generated number. Default=DBL_MAX\n"
+"xxx   - [optional] upper edge of the range of absolute values of generated number. Default=DBL_MAX or FLT_MAX\n"
 "ddd   - [optional] deviation factor. Range [0:1], Default=0.\n"
 "        Non-zero ddd specifies that test point will be chosen from range (MPt-ULP*0.5*ddd:MPt+ULP*0.5*ddd)\n"
 "seed  - [optional] PRNG seed. Default=1\n"
+"-f    - [optional] generate midpoints between binary32 numbers (test vector for strtof)\n"
+"-j    - [optional] generate in nThreads threads. Default - number of hardware threads.\n"
+"        Output does not depend on nThreads\n"
+"file  - [optional] in addition to the text on stdout write binary container of test vector to file\n"
 "-?, ? - show this message"
 ;
 
@@ -53,6 +70,10 @@ int main(int argz, char** argv)
   double fMax = DBL_MAX;
   double dev  = 0;
   int  seed = 1;
+  bool fMaxSet = false;
+  bool f32 = false;
+  unsigned nThreads = 1;
+  const char* binName = NULL;
   for (int arg_i = 1; arg_i < argz; ++arg_i) {
     char* arg = argv[arg_i];
     if (strcmp(arg, "?")==0) {
@@ -67,6 +88,14 @@ int main(int argz, char** argv)
       fprintf(stderr, "%s", UsageStr);
       return 1;
     }
+    if (strcmp(arg, "-f")==0) {
+      f32 = true;
+      continue;
+    }
+    if (strcmp(arg, "-j")==0) {
+      nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+      continue;
+    }
 
     char* eq = strchr(&arg[1], '=');
     if (eq==0) {
@@ -74,8 +103,8 @@ int main(int argz, char** argv)
       return 1;
     }
 
-    enum { O_C, O_FMIN, O_FMAX, O_DEV, O_S, O_UNK };
-    static const char *optstr[] = { "c", "fmin", "fmax", "dev", "s" };
+    enum { O_C, O_FMIN, O_FMAX, O_DEV, O_S, O_J, O_BIN, O_UNK };
+    static const char *optstr[] = { "c", "fmin", "fmax", "dev", "s", "j", "bin" };
     int op = 0;
     for (op = 0; op < O_UNK; ++op) {
       if (0==strncmp(&arg[1], optstr[op], eq-arg-1))
@@ -86,6 +115,7 @@ int main(int argz, char** argv)
     switch (op) {
       case O_C:
       case O_S:
+      case O_J:
       {
         long v = strtol(eq+1, &endp, 0);
         if (endp==eq+1) {
@@ -103,6 +133,13 @@ int main(int argz, char** argv)
           case O_S:
             seed = v;
             break;
+          case O_J:
+            if (v < 1 || v > 1024) {
+              fprintf(stderr, "Bad option '%s'. Please specify number of threads in range [1:1024].\n", arg);
+              return 1;
+            }
+            nThreads = v;
+            break;
         }
       } break;
 
@@ -131,6 +168,7 @@ int main(int argz, char** argv)
               return 1;
             }
             fMax = v;
+            fMaxSet = true;
             break;
 
           case O_DEV:
@@ -143,14 +181,42 @@ int main(int argz, char** argv)
         }
       } break;
 
+      case O_BIN:
+        if (eq[1] == 0) {
+          fprintf(stderr, "Bad option '%s'. Please specify file name.\n", arg);
+          return 1;
+        }
+        binName = eq+1;
+        break;
+
       default:
         fprintf(stderr, "Unknown option '%s'.\n", arg);
         return 1;
     }
   }
 
+  if (f32) {
+    if (!fMaxSet) {
+      fMax = FLT_MAX;
+    } else if (fMax > FLT_MAX) {
+      fprintf(stderr, "Bad option -fmax=%.17e. With -f please specify number in range [%.17e:FLT_MAX].\n", fMax, fMin);
+      return 1;
+    }
+    if (fMin > fMax) {
+      fprintf(stderr, "Bad option -fmin=%.17e. With -f please specify number in range [0:%.17e].\n", fMin, fMax);
+      return 1;
+    }
+  }
+
+  tvbin_writer_t bin;
+  if (binName && !bin.open(binName, 'n', f32))
+    return 1;
+
   MakeTables();
-  return body(nItems, fMin, fMax, seed, dev);
+  int ret = body(nItems, fMin, fMax, seed, dev, f32, nThreads, binName ? &bin : NULL);
+  if (ret == 0 && binName && !bin.close())
+    return 1;
+  return ret;
 }
 
 enum {
@@ -167,75 +233,130 @@ static void MakeTables()
   }
 }
 
-static int body(long nItems, double fMin, double fMax, int seed, double dev)
+static int body(long nItems, double fMin, double fMax, int seed, double dev, bool f32, unsigned nThreads, tvbin_writer_t* bin)
 {
-  std::mt19937_64 gen;
-  gen.seed(seed);
-
-  mpz_t x, xDev;
-  mpz_init(x);
-  mpz_init(xDev);
-  char mntStr[1000];
-  const uint64_t uMin = d2u(fMin);
-  const uint64_t uMax = d2u(fMax);
+  // binary64 or binary32 layout
+  const int      mntBits = f32 ? 24 : 53;
+  const int      expBias = f32 ? 127 : 1023;
+  const int      signPos = f32 ? 31 : 63;
+  const uint64_t uMin = f32 ? f2u(float(fMin)) : d2u(fMin);
+  const uint64_t uMax = f32 ? f2u(float(fMax)) : d2u(fMax);
   const int      devScale = 53;
   const int64_t  devMax = int64_t(ldexp(dev, devScale));
   const uint64_t BIT63 = uint64_t(1) << 63;
-  const uint64_t BIT52 = uint64_t(1) << 52;
-  const uint64_t MSK52 = BIT52 - 1;
-  for (long it = 0; it < nItems; ++it) {
-    // generate random floating point in range [fMin:fmax] and random sign
-    uint64_t rnd = gen();
-    uint64_t u = mulu(rnd*2, uMax+1-uMin) + uMin;
-    uint64_t sign = rnd & BIT63;
-
-    int64_t iDev = 0;
-    if (devMax != 0) // generate random integer in range (-dev*2**53:+dev*2**53)
-      iDev = int64_t(mulu(gen(), devMax*2-1)) - (devMax-1);
-
-    // split into mantissa and exponent
-    int biasedExp = u >> 52;
-    uint64_t mnt = u & MSK52;
-    if (biasedExp > 0)
-      mnt |= BIT52;
-    else
-      biasedExp = 1;
-
-    mpz_set_d(x, double(mnt*2));
-    mpz_add_ui(x, x, 1); // add 0.5 ULP
-    if (iDev != 0) { // add scaled deviation
-      mpz_set_d(xDev, double(iDev));
-      mpz_mul_2exp(x, x, devScale);
-      mpz_add(x, x, xDev);
-    }
+  const uint64_t HIDDEN_BIT = uint64_t(1) << (mntBits-1);
+  const uint64_t MNT_MASK = HIDDEN_BIT - 1;
+  if (f32)
+    printf("nf\n"); // control line: round to nearest, binary32
 
-    // convert to decimal
-    int binExp = biasedExp - 1023 - 53;
-    int decExp = 0;
-    if (iDev != 0)
-      binExp -= devScale;
-    if (binExp < 0) {
-      mpz_mul(x, x, pow5_tab_z[-binExp]);
-      decExp = binExp;
-    } else if (binExp > 0) {
-      mpz_mul_2exp(x, x, binExp);
-    }
+  // Items are generated by blocks of BLOCK_ITEMS. In each round worker t generates block t of the round.
+  // PRNG outputs of the round are drawn sequentially by the calling thread and handed to the workers,
+  // that way the output does not depend on the number of threads.
+  const long BLOCK_ITEMS = 4096;
+  const unsigned rndPerItem = devMax != 0 ? 2 : 1;
+  struct worker_t {
+    std::vector<uint64_t> rnd; // PRNG outputs for the current block
+    long first, last;          // items of the current block
+    mpz_t x, xDev;
+    std::string out; // lines of the current block, each terminated by '\n' and '\0'
+  };
+  std::mt19937_64 gen;
+  gen.seed(seed);
+  std::vector<worker_t> workers(nThreads);
+  for (unsigned t = 0; t < nThreads; ++t) {
+    worker_t& w = workers[t];
+    mpz_init(w.x);
+    mpz_init(w.xDev);
+  }
 
-    mpz_get_str(mntStr, 10, x);
+  // generate items [w.first:w.last) of block t
+  auto genBlock = [&](unsigned t) {
+    worker_t* w = &workers[t];
+    const uint64_t* rnd = w->rnd.data();
+    mpz_t& x = w->x;
+    mpz_t& xDev = w->xDev;
+    char mntStr[1000];
+    char line[sizeof(mntStr) + 48];
+    w->out.clear();
+    for (long it = w->first; it < w->last; ++it) {
+      // generate random floating point in range [fMin:fmax] and random sign
+      uint64_t urnd = *rnd++;
+      uint64_t u = mulu(urnd*2, uMax+1-uMin) + uMin;
+      uint64_t sign = urnd & BIT63;
 
-    const char *tieStr = "";
-    if (iDev == 0) { // round to even
-      uint64_t lsb = (u & 1);
-      u += lsb;
-      tieStr = lsb ? "+" : "-";
-    } else if (iDev > 0) {
-      u += 1;
-    }
+      int64_t iDev = 0;
+      if (devMax != 0) // generate random integer in range (-dev*2**53:+dev*2**53)
+        iDev = int64_t(mulu(*rnd++, devMax*2-1)) - (devMax-1);
 
-    // add sign
-    u |= sign;
+      // split into mantissa and exponent
+      int biasedExp = u >> (mntBits-1);
+      uint64_t mnt = u & MNT_MASK;
+      if (biasedExp > 0)
+        mnt |= HIDDEN_BIT;
+      else
+        biasedExp = 1;
 
-    printf("%s%016" PRIx64 " %s0.%se%d\n", tieStr, u, sign ? "-" : "", mntStr, decExp+int(strlen(mntStr)));
+      mpz_set_d(x, double(mnt*2));
+      mpz_add_ui(x, x, 1); // add 0.5 ULP
+      if (iDev != 0) { // add scaled deviation
+        mpz_set_d(xDev, double(iDev));
+        mpz_mul_2exp(x, x, devScale);
+        mpz_add(x, x, xDev);
+      }
+
+      // convert to decimal
+      int binExp = biasedExp - expBias - mntBits;
+      int decExp = 0;
+      if (iDev != 0)
+        binExp -= devScale;
+      if (binExp < 0) {
+        mpz_mul(x, x, pow5_tab_z[-binExp]);
+        decExp = binExp;
+      } else if (binExp > 0) {
+        mpz_mul_2exp(x, x, binExp);
+      }
+
+      mpz_get_str(mntStr, 10, x);
+
+      const char *tieStr = "";
+      if (iDev == 0) { // round to even
+        uint64_t lsb = (u & 1);
+        u += lsb;
+        tieStr = lsb ? "+" : "-";
+      } else if (iDev > 0) {
+        u += 1;
+      }
+
+      // add sign
+      if (sign)
+        u |= uint64_t(1) << signPos;
+
+      int len = snprintf(line, sizeof(line), "%s%016" PRIx64 " %s0.%se%d\n", tieStr, u, sign ? "-" : "", mntStr, decExp+int(strlen(mntStr)));
+      w->out.append(line, len+1);
+    }
+  };
+
+  worker_pool_t pool(nThreads);
+  for (long round = 0; round < nItems; round += BLOCK_ITEMS*nThreads) {
+    unsigned nActive = unsigned(std::min((nItems - round + BLOCK_ITEMS - 1)/BLOCK_ITEMS, long(nThreads)));
+    for (unsigned t = 0; t < nActive; ++t) {
+      worker_t& w = workers[t];
+      w.first = round + BLOCK_ITEMS*t;
+      w.last  = std::min(w.first + BLOCK_ITEMS, nItems);
+      w.rnd.resize((w.last - w.first)*rndPerItem);
+      for (uint64_t& r : w.rnd)
+        r = gen();
+    }
+    pool.run(nActive, genBlock);
+    // output in order
+    for (unsigned t = 0; t < nActive; ++t) {
+      const std::string& out = workers[t].out;
+      for (size_t pos = 0; pos < out.size(); pos += strlen(&out[pos]) + 1) {
+        fputs(&out[pos], stdout);
+        if (bin && !bin->addLine(&out[pos]))
+          return 1;
+      }
+    }
   }
   return 0;
 }
@@ -0,0 +1,137 @@
+// Measure per-call cost of looking up decimal point character of the current locale
+// by different methods, running the same loop in 1 or more threads concurrently.
+// POSIX only.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
+#include <langinfo.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#ifdef MY_STRTOD
+ extern "C" double my_strtod(const char* str, char** str_end);
+ extern "C" double my_strtod_l(const char* str, char** str_end, locale_t loc);
+#endif
+
+static locale_t thrLocale; // used by nl_langinfo_l and my_strtod_l methods
+
+static long lookup_localeconv(long n) {
+  long acc = 0;
+  for (long i = 0; i < n; ++i)
+    acc += localeconv()->decimal_point[0];
+  return acc;
+}
+
+static long lookup_nl_langinfo(long n) {
+  long acc = 0;
+  for (long i = 0; i < n; ++i)
+    acc += nl_langinfo(RADIXCHAR)[0];
+  return acc;
+}
+
+static long lookup_nl_langinfo_l(long n) {
+  long acc = 0;
+  for (long i = 0; i < n; ++i)
+    acc += nl_langinfo_l(RADIXCHAR, thrLocale)[0];
+  return acc;
+}
+
+#ifdef MY_STRTOD
+static long cvt_my_strtod(long n) {
+  long acc = 0;
+  for (long i = 0; i < n; ++i)
+    acc += (long)my_strtod("1", NULL);
+  return acc;
+}
+
+static long cvt_my_strtod_l(long n) {
+  long acc = 0;
+  for (long i = 0; i < n; ++i)
+    acc += (long)my_strtod_l("1", NULL, thrLocale);
+  return acc;
+}
+#endif
+
+// run fn(nCalls) in nThreads concurrently, return nsec per call in each thread
+static double measure(long (*fn)(long), int nThreads, long nCalls)
+{
+  std::vector<std::thread> thr;
+  std::vector<long> res(nThreads);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < nThreads; ++i)
+    thr.emplace_back([&res, fn, i, nCalls] { res[i] = fn(nCalls); });
+  for (auto& t : thr)
+    t.join();
+  auto t1 = std::chrono::steady_clock::now();
+  auto nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+  return double(nsec.count())/nCalls;
+}
+
+int main(int argz, char** argv)
+{
+  int  nThreads = 1;
+  long nCalls   = 10000000;
+  const char* locName = "";
+  for (int arg_i = 1; arg_i < argz; ++arg_i) {
+    char* arg = argv[arg_i];
+    if (arg[0] == '?' || strcmp(arg, "-?")==0) {
+      fprintf(stderr,
+        "Usage:\n%s [-t=nThreads] [-c=nCalls] [-loc=locale]\n"
+        "where\n"
+        "nThreads - [optional] number of concurrently running threads. Range [1:256]. Default 1.\n"
+        "nCalls   - [optional] number of calls in each thread. Default 10000000.\n"
+        "locale   - [optional] name of locale. Default - taken from environment.\n"
+        , argv[0]);
+      return 1;
+    } else if (strncmp(arg, "-t=", 3)==0) {
+      nThreads = atoi(&arg[3]);
+      if (nThreads < 1 || nThreads > 256) {
+        fprintf(stderr, "Illegal number of threads '%s'.\n", &arg[3]);
+        return 1;
+      }
+    } else if (strncmp(arg, "-c=", 3)==0) {
+      nCalls = atol(&arg[3]);
+      if (nCalls < 1) {
+        fprintf(stderr, "Illegal number of calls '%s'.\n", &arg[3]);
+        return 1;
+      }
+    } else if (strncmp(arg, "-loc=", 5)==0) {
+      locName = &arg[5];
+    } else {
+      fprintf(stderr, "Unknown option '%s'.\n", arg);
+      return 1;
+    }
+  }
+
+  if (!setlocale(LC_ALL, locName)) {
+    fprintf(stderr, "Failed to set locale '%s'.\n", locName);
+    return 1;
+  }
+  thrLocale = newlocale(LC_ALL_MASK, locName, (locale_t)0);
+  if (!thrLocale) {
+    fprintf(stderr, "Failed to create locale '%s'.\n", locName);
+    return 1;
+  }
+  printf("locale '%s', decimal point '%c'. %d thread(s). nsec/call in each thread:\n"
+    , setlocale(LC_NUMERIC, NULL), localeconv()->decimal_point[0], nThreads);
+
+  static const struct {
+    const char* name;
+    long (*fn)(long);
+  } methods[] = {
+    { "localeconv()",       lookup_localeconv    },
+    { "nl_langinfo()",      lookup_nl_langinfo   },
+    { "nl_langinfo_l()",    lookup_nl_langinfo_l },
+#ifdef MY_STRTOD
+    { "my_strtod(\"1\")",   cvt_my_strtod        },
+    { "my_strtod_l(\"1\")", cvt_my_strtod_l      },
+#endif
+  };
+  for (auto& m : methods)
+    printf("%-18s %8.2f\n", m.name, measure(m.fn, nThreads, nCalls));
+
+  freelocale(thrLocale);
+  return 0;
+}
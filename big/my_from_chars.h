@@ -0,0 +1,79 @@
+#ifndef MY_FROM_CHARS_H
+#define MY_FROM_CHARS_H
+
+// from_chars()-style conversion, implemented in my_strtod99.c
+// Unlike my_strtod(), it does not depend on locale (decimal point is always '.'),
+// on floating-point environment (rounding is always to nearest) and on errno.
+// Leading whitespace characters and '+' sign are not accepted.
+// Define MY_FROM_CHARS_HEADER_ONLY to compile my_strtod99.c together with the caller instead of linking it
+
+enum {
+  MY_CHARS_FORMAT_SCIENTIFIC = 1, // exponent required
+  MY_CHARS_FORMAT_FIXED      = 2, // exponent not accepted
+  MY_CHARS_FORMAT_HEX        = 4, // hexadecimal mantissa without "0x" prefix, optional binary exponent
+  MY_CHARS_FORMAT_GENERAL    = MY_CHARS_FORMAT_FIXED | MY_CHARS_FORMAT_SCIENTIFIC,
+};
+
+enum {
+  MY_FROM_CHARS_OK           = 0,
+  MY_FROM_CHARS_INVALID      = 1, // no conversion can be performed, *ptr = first
+  MY_FROM_CHARS_OUT_OF_RANGE = 2, // value is too big or too small to be represented as non-zero binary64
+};
+
+#ifdef MY_FROM_CHARS_HEADER_ONLY
+// my_strtod99.c is compiled as a part of the including translation unit and all its external functions
+// become static inline, so my_from_chars() and from_chars() can be inlined into the caller.
+// The including translation unit also gets all internal names of my_strtod99.c.
+// Can be used from C and from C++. Not compatible with MY_STRTOD_STATS
+#ifdef MY_STRTOD_STATS
+#error MY_FROM_CHARS_HEADER_ONLY is not compatible with MY_STRTOD_STATS
+#endif
+#define MY_STRTOD_API static inline
+#include "my_strtod99.c"
+#else
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Convert string in range [first:last). Never reads at or beyond last.
+// *ptr - end of the matched part of the string. *value is not modified unless result is MY_FROM_CHARS_OK
+int my_from_chars(const char* first, const char* last, double* value, int fmt, const char** ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
+
+#ifdef __cplusplus
+
+#include <system_error>
+
+namespace my {
+
+enum class chars_format {
+  scientific = MY_CHARS_FORMAT_SCIENTIFIC,
+  fixed      = MY_CHARS_FORMAT_FIXED,
+  hex        = MY_CHARS_FORMAT_HEX,
+  general    = MY_CHARS_FORMAT_GENERAL,
+};
+
+struct from_chars_result {
+  const char* ptr;
+  std::errc   ec;
+};
+
+// The same semantics as std::from_chars() for double
+inline from_chars_result from_chars(const char* first, const char* last, double& value, chars_format fmt = chars_format::general)
+{
+  const char* ptr;
+  switch (my_from_chars(first, last, &value, static_cast<int>(fmt), &ptr)) {
+    case MY_FROM_CHARS_OK:           return from_chars_result{ptr, std::errc()};
+    case MY_FROM_CHARS_OUT_OF_RANGE: return from_chars_result{ptr, std::errc::result_out_of_range};
+    default:                         return from_chars_result{ptr, std::errc::invalid_argument};
+  }
+}
+
+} // namespace my
+#endif
+
+#endif // MY_FROM_CHARS_H
@@ -19,6 +19,29 @@ typedef struct {
   int         decExp;
 } parse_t;
 
+#ifdef MY_STRTOD_STATS
+#include "my_strtod_stats.h"
+#ifdef _MSC_VER
+static __declspec(thread) my_strtod_stats_t stats;
+#else
+static _Thread_local my_strtod_stats_t stats;
+#endif
+#define STATS_INC(field) (++stats.field)
+
+void my_strtod_stats_get(my_strtod_stats_t* dst)
+{
+  *dst = stats;
+  dst->nSlowInt = stats.nSlow - stats.nSlowFrac;
+}
+
+void my_strtod_stats_reset(void)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+#else
+#define STATS_INC(field) ((void)0)
+#endif
+
 static uint64_t quickCore(uint64_t mntL, uint64_t mntH, int decExp, bool* done);
 static int compareSrcWithMidpoint(parse_t* src, uint64_t u); // return -1,0,+1 when source string respectively <, = or > of u2d(u)+0.5ULP
 
@@ -28,13 +51,20 @@ static double u2d(uint64_t x) {
   return y;
 }
 
-static const char* parseTail(parse_t* dst, const char* str, int i)
+// Character at str[i] or terminating zero when &str[i] is at or beyond last.
+// last == NULL designates zero-terminated string
+static inline char chAt(const char* str, int i, const char* last)
+{
+  return (last && &str[i] >= last) ? 0 : str[i];
+}
+
+static const char* parseTail(parse_t* dst, const char* str, int i, const char* last)
 {
   if (dst->dotI < 0) // there was no dot
     dst->dotI = i;   // implied dot after mantissa
 
   const char* ret = &str[i];
-  switch (str[i]) {
+  switch (chAt(str, i, last)) {
     case 'e':
     case 'E':
       break; // exponent
@@ -46,7 +76,7 @@ static const char* parseTail(parse_t* dst, const char* str, int i)
   // exponent
   ++i;
   // process sign
-  char neg = str[i];
+  char neg = chAt(str, i, last);
   switch (neg) {
     case '+':
     case '-':
@@ -56,11 +86,11 @@ static const char* parseTail(parse_t* dst, const char* str, int i)
       break;
   }
 
-  if ((unsigned)(str[i]-'0') > 9)
+  if ((unsigned)(chAt(str, i, last)-'0') > 9)
     return ret; // no exponent, done
 
   // look for the first non-zero digit
-  while (str[i] == '0') {
+  while (chAt(str, i, last) == '0') {
     if (i == INPLEN_MAX)
       return NULL; // input too long
     ++i;
@@ -69,7 +99,7 @@ static const char* parseTail(parse_t* dst, const char* str, int i)
   // accumulate decExp
   int decExp = 0;
   do {
-    unsigned char dig = *(unsigned char*)&str[i] - '0';
+    unsigned char dig = (unsigned char)chAt(str, i, last) - '0';
     if (dig > 9)
       break;
     decExp = decExp * 10 + dig;
@@ -81,7 +111,7 @@ static const char* parseTail(parse_t* dst, const char* str, int i)
 
   // look for the end of exponent
   for (; i < INPLEN_MAX; ++i) {
-    unsigned char dig = *(unsigned char*)&str[i] - '0';
+    unsigned char dig = (unsigned char)chAt(str, i, last) - '0';
     if (dig > 9)
       return &str[i]; // end found
   }
@@ -89,10 +119,10 @@ static const char* parseTail(parse_t* dst, const char* str, int i)
   return NULL; // input too long
 }
 
-static const char* parse(parse_t* dst, const char* str)
+static const char* parse(parse_t* dst, const char* str, const char* last)
 {
   int  i  = 0;
-  char c0 = str[0];
+  char c0 = chAt(str, 0, last);
   char dotC = '.';
   dst->dotI = -1; // no dot
   if ((unsigned)(c0-'0') > 9) {
@@ -100,7 +130,7 @@ static const char* parse(parse_t* dst, const char* str)
       return NULL; // illegal input
     dst->dotI = 1; // record the next index, when dot found before the end of mnt
     dotC = '0';
-    if ((unsigned)(str[1]-'0') > 9)
+    if ((unsigned)(chAt(str, 1, last)-'0') > 9)
       return NULL; // illegal input
     i = 1;
   }
@@ -108,18 +138,18 @@ static const char* parse(parse_t* dst, const char* str)
 
   // look for the first non-zero digit
   for (;;) {
-    while (str[i] == '0') {
+    while (chAt(str, i, last) == '0') {
       if (i == INPLEN_MAX)
         return NULL; // input too long
       ++i;
     }
 
-    c0 = str[i];
+    c0 = chAt(str, i, last);
     if ((unsigned)(c0-'0') <= 9)
       break; // non-zero digit found
 
     if (c0 != dotC)
-      return parseTail(dst, str, i);
+      return parseTail(dst, str, i, last);
 
     // dot found
     dst->dotI = i+1; // record the next index, when dot found before the end of mnt
@@ -132,11 +162,11 @@ static const char* parse(parse_t* dst, const char* str)
   dst->nz0 = &str[i];
   uint64_t mnt = 0;
   for (int k = 0; k < PARSE_DIG;) {
-    unsigned char dig = *(unsigned char*)&str[i] - '0';
+    unsigned char dig = (unsigned char)chAt(str, i, last) - '0';
     if (dig <= 9) {
       mnt = mnt * 10 + dig;
       ++k;
-    } else if (str[i] == dotC) {
+    } else if (chAt(str, i, last) == dotC) {
       // dot found
       dst->dot = &str[i];
       dst->dotI = i+1; // record the next index, when dot found before the end of mnt
@@ -153,7 +183,7 @@ static const char* parse(parse_t* dst, const char* str)
   // look for the end of mantissa
   int nzlast_i = -1;
   for (; i < INPLEN_MAX; ++i) {
-    c0 = str[i];
+    c0 = chAt(str, i, last);
     if (c0 >= '0' && c0 <= '9') {
       if (c0 != '0')
         nzlast_i = i;
@@ -166,7 +196,7 @@ static const char* parse(parse_t* dst, const char* str)
       // end of mantissa found
       if (nzlast_i >= 0)
         dst->nzlast = &str[nzlast_i];
-      return parseTail(dst, str, i);
+      return parseTail(dst, str, i, last);
     }
   }
 
@@ -185,14 +215,15 @@ static const char* find_nzlast(const char* beg, const char* end)
   return ret;
 }
 
-double my_strtod(const char* str, char** str_end)
+static inline double cvt(const char* str, const char* last, char** str_end)
 {
+  STATS_INC(nCalls);
   // discard leading whitespace characters
   const char* pstr = str;
-  while (isspace(*pstr)) ++pstr;
+  while (isspace(chAt(pstr, 0, last))) ++pstr;
 
   // process sign
-  char neg = *pstr;
+  char neg = chAt(pstr, 0, last);
   switch (neg) {
     case '+':
     case '-':
@@ -206,7 +237,7 @@ double my_strtod(const char* str, char** str_end)
     *str_end = (char*)str;
 
   parse_t prs = {0};
-  const char* endp= parse(&prs, pstr);
+  const char* endp= parse(&prs, pstr, last);
   if (endp == 0)
     return 0;
 
@@ -219,19 +250,26 @@ double my_strtod(const char* str, char** str_end)
 
   int decExp = prs.decExp + prs.dotI - prs.eomI;
 
-  if (decExp < -324-PARSE_DIG)
+  if (decExp < -324-PARSE_DIG) {
+    STATS_INC(nOverUnder);
     return u2d(signBit);
+  }
 
   const uint64_t uINF = (uint64_t)2047 << 52;
-  if (decExp > 308)
+  if (decExp > 308) {
+    STATS_INC(nOverUnder);
     return u2d(uINF+signBit);
+  }
 
   bool done;
   uint64_t uRet = quickCore(prs.mnt, prs.mnt + (prs.nzlast != 0), decExp, &done);
-  if (done)
+  if (done) {
+    STATS_INC(nQuickDone);
     return u2d(uRet+signBit);
+  }
 
   // Blitzkrieg didn't work, let's do it slowly
+  STATS_INC(nSlow);
   if (prs.nzlast==0)
     prs.nzlast = find_nzlast(prs.nz0, prs.eom);
 
@@ -241,6 +279,18 @@ double my_strtod(const char* str, char** str_end)
   return u2d(uRet+signBit);
 }
 
+double my_strtod(const char* str, char** str_end)
+{
+  return cvt(str, NULL, str_end);
+}
+
+// Convert string in range [first:last) that is not necessarily zero-terminated.
+// Never reads at or beyond last. Otherwise the same as my_strtod()
+double my_strtod_n(const char* first, const char* last, char** str_end)
+{
+  return cvt(first, last, str_end);
+}
+
 const static uint64_t tab1[28] = { // 5**k
   1ull,
   5ull,
@@ -601,6 +651,7 @@ static int compareSrcWithMidpoint(parse_t* src, uint64_t u)
   }
 
   // compare the rest of fractional bits, 27 digits at time
+  STATS_INC(nSlowFrac);
   // x[] contains mantissa of Thr
   const char* nonDigit = end_str; // points to first input character that shouldn't be treated as digit
   if (src->dot != NULL && src->dot < end_str && src->dot >= str)
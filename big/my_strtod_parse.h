@@ -0,0 +1,621 @@
+#ifndef MY_STRTOD_PARSE_H
+#define MY_STRTOD_PARSE_H
+
+// Parser of decimal and hexadecimal floating-point strings, front end of my_strtod99.c and my_strtof.c.
+// Included into their source files, all functions are static.
+// The including file defines LIKELY, UNLIKELY and ALWAYS_INLINE and, when it collects statistics,
+// STATS_INC and STATS_ADD.
+#include <stdint.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include "my_from_chars.h" // MY_CHARS_FORMAT_xxx
+
+#ifndef STATS_INC
+#define STATS_INC(field)      ((void)0)
+#define STATS_ADD(field, val) ((void)0)
+#endif
+
+// SIMD front end of mantissa parsing. Selected at run time by means of CPUID.
+// Compile with -DMY_STRTOD_NO_SIMD in order to get pure scalar code.
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(MY_STRTOD_NO_SIMD)
+#define MY_STRTOD_SIMD 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_SSE41
+#define TARGET_AVX2
+#else
+#define TARGET_SSE41    __attribute__((target("sse4.1")))
+#define TARGET_AVX2     __attribute__((target("avx2")))
+#endif
+// For zero-terminated strings SIMD loads may read beyond the terminating zero, up to the end of
+// the aligned block or of the page. It never faults, but AddressSanitizer reports it as overflow,
+// so under sanitizer zero-terminated strings are parsed by scalar code.
+// Bounded strings never read at or beyond last and use SIMD code regardless.
+#if defined(__SANITIZE_ADDRESS__)
+#define MY_STRTOD_SIMD_NO_OVERREAD 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define MY_STRTOD_SIMD_NO_OVERREAD 1
+#endif
+#endif
+#endif
+
+#define MNT_MAX ((uint64_t)-1)
+
+enum {
+  INPLEN_MAX = 100000, // maximal length of mantissa part of legal input string, not including leading whitespace characters and sign
+};
+
+typedef struct {
+  uint64_t    mnt;
+  const char* eom;    // end of part of mantissa accumulated within mnt
+  const char* lastDig;// last non-zero digit of mantissa. Recorded only when there is at least one non-zero digit after eom
+  const char* dot;    // dot character. Recorded only when dot encountered at or after eom
+  int         decExp;
+  int         binExp; // binary exponent of hexadecimal floating-point
+  bool        hexFloat;
+  uint64_t    signBit;// sign bit of binary64 result. When mnt==0 - binary64 bit pattern of the result (signed zero, Inf or NaN)
+} parse_t;
+#ifdef MY_STRTOD_SIMD
+const static uint64_t simdPow10[19] = { // 10**k
+  1ull,
+  10ull,
+  100ull,
+  1000ull,
+  10000ull,
+  100000ull,
+  1000000ull,
+  10000000ull,
+  100000000ull,
+  1000000000ull,
+  10000000000ull,
+  100000000000ull,
+  1000000000000ull,
+  10000000000000ull,
+  100000000000000ull,
+  1000000000000000ull,
+  10000000000000000ull,
+  100000000000000000ull,
+  1000000000000000000ull,
+};
+#endif
+
+static bool is_case_insensitively_equal(const char* x, const char* uppercaseRef, unsigned len) {
+  for (unsigned i = 0; i < len; ++i)
+    if (toupper(x[i]) != uppercaseRef[i])
+      return false;
+  return true;
+}
+
+// Character at p or terminating zero when p is at or beyond last.
+// last == NULL designates zero-terminated string, then the check folds away
+static ALWAYS_INLINE char peekc(const char* p, const char* last)
+{
+  return (last && p >= last) ? 0 : *p;
+}
+
+// At least n characters available at p
+static ALWAYS_INLINE bool hasChars(const char* p, const char* last, int n)
+{
+  return !last || last - p >= n;
+}
+
+#ifdef MY_STRTOD_SIMD
+enum {
+  SIMD_NONE  = 0,
+  SIMD_SSE41 = 1,
+  SIMD_AVX2  = 2,
+};
+
+// Detected lazily by the first call. Concurrent first calls detect the same value, so the only
+// requirement is that load and store are atomic
+#ifdef _MSC_VER
+static volatile long simdLevel = -1; // not yet detected
+#define SIMD_LEVEL_LOAD()     ((int)simdLevel)
+#define SIMD_LEVEL_STORE(val) (simdLevel = (val))
+#else
+static int simdLevel = -1; // not yet detected
+#define SIMD_LEVEL_LOAD()     __atomic_load_n(&simdLevel, __ATOMIC_RELAXED)
+#define SIMD_LEVEL_STORE(val) __atomic_store_n(&simdLevel, (val), __ATOMIC_RELAXED)
+#endif
+
+static int detectSimdLevel(void)
+{
+#ifdef _MSC_VER
+  int info[4];
+  __cpuid(info, 0);
+  int maxLeaf = info[0];
+  __cpuid(info, 1);
+  if ((info[2] & (1 << 19)) == 0) // SSE4.1
+    return SIMD_NONE;
+  if ((info[2] & (1 << 27)) == 0 || maxLeaf < 7) // OSXSAVE
+    return SIMD_SSE41;
+  if ((_xgetbv(0) & 6) != 6) // OS preserves XMM and YMM state
+    return SIMD_SSE41;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) ? SIMD_AVX2 : SIMD_SSE41;
+#else
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("sse4.1"))
+    return SIMD_NONE;
+  return __builtin_cpu_supports("avx2") ? SIMD_AVX2 : SIMD_SSE41;
+#endif
+}
+
+static ALWAYS_INLINE int getSimdLevel(void)
+{
+  int level = SIMD_LEVEL_LOAD();
+  if (UNLIKELY(level < 0)) {
+    level = detectSimdLevel();
+    SIMD_LEVEL_STORE(level);
+  }
+  return level;
+}
+
+static ALWAYS_INLINE bool can_load16(const char* p, const char* last)
+{ // 16-byte load at p does not cross page boundary or, for bounded string, its end
+#ifdef MY_STRTOD_SIMD_NO_OVERREAD
+  return last && last - p >= 16;
+#else
+  return last ? last - p >= 16 : ((uintptr_t)p & 4095) <= 4096-16;
+#endif
+}
+
+// Convert up to 16 leading decimal digits of the string src to binary
+// Return number of converted digits, store their value in *pVal
+// Inlined into callers with different targets, so AVX2 callers get VEX-encoded copy
+// and avoid penalties of transitions between legacy SSE and AVX code
+static ALWAYS_INLINE TARGET_SSE41 int readDigits16(const char* src, uint64_t* pVal)
+{
+  static const int8_t alignTab[32] = { // pshufb controls that move n leading bytes to the end
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+  };
+  __m128i dig  = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)src), _mm_set1_epi8('0'));
+  __m128i isDig= _mm_cmpeq_epi8(_mm_min_epu8(dig, _mm_set1_epi8(9)), dig);
+  unsigned msk = (unsigned)_mm_movemask_epi8(isDig);
+  int n;
+#ifdef _MSC_VER
+  unsigned long idx;
+  _BitScanForward(&idx, ~msk);
+  n = (int)idx;
+#else
+  n = __builtin_ctz(~msk);
+#endif
+  // right-align n digits, leading bytes are zeroed
+  dig = _mm_shuffle_epi8(dig, _mm_loadu_si128((const __m128i*)&alignTab[n]));
+  __m128i d2 = _mm_maddubs_epi16(dig, _mm_set1_epi16(0x010A));  // 8 x 2 digits
+  __m128i d4 = _mm_madd_epi16(d2, _mm_set1_epi32(0x00010064));  // 4 x 4 digits
+  d4 = _mm_packus_epi32(d4, d4);
+  __m128i d8 = _mm_madd_epi16(d4, _mm_set1_epi32(0x00012710));  // 2 x 8 digits
+  *pVal = (uint64_t)(uint32_t)_mm_cvtsi128_si32(d8)*100000000u + (uint32_t)_mm_extract_epi32(d8, 1);
+  return n;
+}
+
+static TARGET_SSE41 int simdReadDigits16_sse41(const char* src, uint64_t* pVal)
+{
+  return readDigits16(src, pVal);
+}
+
+static TARGET_AVX2 int simdReadDigits16_avx2(const char* src, uint64_t* pVal)
+{
+  return readDigits16(src, pVal);
+}
+
+#ifndef MY_STRTOD_SIMD_NO_OVERREAD
+// Return pointer to the first non-digit character at or after p
+// Loads are aligned, so they never cross page boundary
+static TARGET_AVX2 const char* simdSkipDigits32(const char* p)
+{
+  const char* blk = (const char*)((uintptr_t)p & -(uintptr_t)32);
+  unsigned skip = (unsigned)(p - blk);
+  for (;;) {
+    __m256i dig   = _mm256_sub_epi8(_mm256_load_si256((const __m256i*)blk), _mm256_set1_epi8('0'));
+    __m256i isDig = _mm256_cmpeq_epi8(_mm256_min_epu8(dig, _mm256_set1_epi8(9)), dig);
+    uint32_t nonDigMsk = ~(uint32_t)_mm256_movemask_epi8(isDig) >> skip << skip;
+    if (nonDigMsk != 0) {
+#ifdef _MSC_VER
+      unsigned long idx;
+      _BitScanForward(&idx, nonDigMsk);
+      return blk + idx;
+#else
+      return blk + __builtin_ctz(nonDigMsk);
+#endif
+    }
+    blk += 32;
+    skip = 0;
+  }
+}
+#endif
+
+// Bounded variant. Unaligned loads, never beyond last. The tail shorter than 16 characters is left to the caller
+static ALWAYS_INLINE TARGET_SSE41 const char* skipDigitsN16(const char* p, const char* last)
+{
+  while (last - p >= 16) {
+    __m128i dig   = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)p), _mm_set1_epi8('0'));
+    __m128i isDig = _mm_cmpeq_epi8(_mm_min_epu8(dig, _mm_set1_epi8(9)), dig);
+    unsigned nonDigMsk = ~(unsigned)_mm_movemask_epi8(isDig) & 0xFFFF;
+    if (nonDigMsk != 0) {
+#ifdef _MSC_VER
+      unsigned long idx;
+      _BitScanForward(&idx, nonDigMsk);
+      return p + idx;
+#else
+      return p + __builtin_ctz(nonDigMsk);
+#endif
+    }
+    p += 16;
+  }
+  return p;
+}
+
+static TARGET_SSE41 const char* simdSkipDigitsN_sse41(const char* p, const char* last)
+{
+  return skipDigitsN16(p, last);
+}
+
+static TARGET_AVX2 const char* simdSkipDigitsN_avx2(const char* p, const char* last)
+{
+  return skipDigitsN16(p, last);
+}
+
+#ifndef MY_STRTOD_SIMD_NO_OVERREAD
+static TARGET_SSE41 const char* simdSkipDigits16(const char* p)
+{
+  const char* blk = (const char*)((uintptr_t)p & -(uintptr_t)16);
+  unsigned skip = (unsigned)(p - blk);
+  for (;;) {
+    __m128i dig   = _mm_sub_epi8(_mm_load_si128((const __m128i*)blk), _mm_set1_epi8('0'));
+    __m128i isDig = _mm_cmpeq_epi8(_mm_min_epu8(dig, _mm_set1_epi8(9)), dig);
+    unsigned nonDigMsk = (~(unsigned)_mm_movemask_epi8(isDig) & 0xFFFF) >> skip << skip;
+    if (nonDigMsk != 0) {
+#ifdef _MSC_VER
+      unsigned long idx;
+      _BitScanForward(&idx, nonDigMsk);
+      return blk + idx;
+#else
+      return blk + __builtin_ctz(nonDigMsk);
+#endif
+    }
+    blk += 16;
+    skip = 0;
+  }
+}
+#endif
+#endif
+
+// Return pointer to the first non-digit character at or after p
+static ALWAYS_INLINE const char* skipDigits(const char* p, const char* last)
+{
+#ifdef MY_STRTOD_SIMD
+  if ((unsigned char)(peekc(p, last) - '0') <= 9) {
+    if (last) {
+      switch (getSimdLevel()) {
+        case SIMD_AVX2:  p = simdSkipDigitsN_avx2(p, last);  break;
+        case SIMD_SSE41: p = simdSkipDigitsN_sse41(p, last); break;
+        default:         break;
+      }
+    } else {
+#ifndef MY_STRTOD_SIMD_NO_OVERREAD
+      switch (getSimdLevel()) {
+        case SIMD_AVX2:  return simdSkipDigits32(p);
+        case SIMD_SSE41: return simdSkipDigits16(p);
+        default:         break;
+      }
+#endif
+    }
+  }
+#endif
+  while ((unsigned char)(peekc(p, last) - '0') <= 9)
+    ++p;
+  return p;
+}
+
+static ALWAYS_INLINE bool isHexDigit(char c)
+{
+  return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f');
+}
+
+// Accumulate hexadecimal mantissa that starts at hexstr into *pMnt
+// dotC - decimal point character, '0' when the dot was found before hexstr
+// *pEom, *pDot and *pEffDot are updated in the same way as in decimal mantissa loop of parseSrc()
+// Return end of the mantissa or NULL when there are no hexadecimal digits
+static ALWAYS_INLINE const char* parseHexMnt(const char* hexstr, const char* last, char dotC,
+  uint64_t* pMnt, const char** pEom, const char** pDot, const char** pEffDot)
+{
+  const uint64_t HEX_MNT_LIMIT = (uint64_t)1 << 56;
+  uint64_t mnt = 0;
+  const char* p = hexstr;
+  for (;;) {
+    for (;;) {
+      unsigned char uc = (unsigned char)peekc(p, last);
+      unsigned char dig = uc - '0';
+      if (dig > 9) {
+        dig = uc - 'A';
+        if (dig > 5) {
+          dig = uc - 'a';
+          if (dig > 5) {
+            break; // non-digit
+          }
+        }
+        dig += 10; // 'A' to 'F' or 'a' to 'f'
+      }
+      ++p;
+      mnt = mnt * 16 + dig;
+      if (UNLIKELY(mnt > HEX_MNT_LIMIT)) {
+        // No more room in mnt.
+        *pEom = p;
+        // Scan throw the rest of mantissa digits
+        char hexStickyChars = '0'; // all non-dot characters after mnt ored together
+        for (;;) {
+          char c = peekc(p, last);
+          while (isHexDigit(c)) {
+            hexStickyChars |= c;
+            c = peekc(++p, last);
+          }
+          if (c != dotC)
+            break;
+          // dot found
+          *pDot = *pEffDot = p;
+          dotC = '0';
+          ++p;
+        }
+        if (hexStickyChars != '0')
+          mnt |= 1;
+        *pMnt = mnt;
+        return p;
+      }
+    }
+    if (peekc(p, last) != dotC) {
+      if (p==hexstr)
+        return NULL; // there were no digits
+      *pEom = p;
+      *pMnt = mnt;
+      return p;
+    }
+    // dot found
+    *pEffDot = p + 1; // record the next position, when dot found before the end of mnt
+    dotC = '0';
+    ++p;
+  }
+}
+
+// Parse source string and store the results in dst
+// The string ends at terminating zero or at last, whichever comes first. last == NULL - no bound
+// fmt == 0 - strtod() syntax, otherwise from_chars() syntax, restricted by MY_CHARS_FORMAT_xxx flags:
+// no leading whitespace, no '+' sign, no "0x" prefix, exponent required/disallowed per fmt
+// Return end of the converted part of the string or NULL when no conversion can be performed
+static ALWAYS_INLINE const char* parseSrc(parse_t* dst, const char* str, const char* last, char dotC, int fmt)
+{
+  // discard leading whitespace characters
+  if (fmt == 0)
+    while (isspace(peekc(str, last))) ++str;
+
+  // process sign
+  char neg = peekc(str, last);
+  switch (neg) {
+    case '+':
+      if (fmt == 0)
+        ++str;
+      break;
+    case '-':
+      ++str;
+      break;
+    default:
+      break;
+  }
+
+  const char* effDot = NULL; // no dot
+  if (peekc(str, last) == dotC) { // dot found before the 1st digit
+    ++str;
+    effDot = str; // record the next position, when dot found before the end of mnt
+    dotC = '0';
+  }
+
+  const uint64_t uINF = (uint64_t)2047 << 52;
+  const uint64_t uNaN = (uint64_t)-1 >> 1;
+
+  // accumulate mantissa
+  uint64_t signBit = (neg=='-') ? (uint64_t)1 << 63 : 0;
+  const char* p = str;
+  const uint64_t DEC_MNT_LIMIT = (MNT_MAX - 9)/10;
+  uint64_t mnt = 0;
+  const char* eom = NULL;    // end of part of mantissa accumulated within mnt
+  const char* dot = NULL;    // dot character. Recorded only when dot encountered at or after eom
+  const char* lastDig = NULL;// last non-zero digit of mantissa. Recorded only when there is at least one non-zero digit after eom
+  bool hexFloat = false;
+#ifdef MY_STRTOD_SIMD
+  const int simdLvl = getSimdLevel();
+#endif
+  if ((fmt & MY_CHARS_FORMAT_HEX) && isHexDigit(peekc(p, last))) {
+    // from_chars() hexadecimal format - mantissa has no "0x" prefix
+    p = parseHexMnt(p, last, dotC, &mnt, &eom, &dot, &effDot);
+    hexFloat = true;
+    goto mantissa_done;
+  }
+  for (;;) {
+#ifdef MY_STRTOD_SIMD
+    // accumulate up to 16 digits at once, as long as mnt stays below 10**18,
+    // i.e. far from DEC_MNT_LIMIT. The rest is up to scalar loop below
+    // p[1] is examined only after p[0] is known to be a digit, i.e. not a terminating zero
+    if (simdLvl != SIMD_NONE && (unsigned char)(peekc(p, last) - '0') <= 9 && (unsigned char)(peekc(p+1, last) - '0') <= 9 && can_load16(p, last)) {
+      uint64_t val;
+      int n = simdLvl == SIMD_AVX2 ? simdReadDigits16_avx2(p, &val) : simdReadDigits16_sse41(p, &val);
+      if (mnt < simdPow10[18-n]) {
+        mnt = mnt * simdPow10[n] + val;
+        p  += n;
+      }
+    }
+#endif
+    for (;;) {
+      unsigned char dig = (unsigned char)peekc(p, last) - '0';
+      if (dig > 9)
+        break; // non-digit
+      ++p;
+      mnt = mnt * 10 + dig;
+      if (UNLIKELY(mnt > DEC_MNT_LIMIT)) {
+        // No more room in mnt.
+        eom  = p;
+        // Scan throw the rest of mantissa digits
+        for (;;) {
+          p = skipDigits(p, last);
+          char c = peekc(p, last);
+          if (c != dotC)
+            break;
+          // dot found
+          dot = effDot = p;
+          dotC = '0';
+          ++p;
+        }
+        if (p > eom) {
+          // look for last non-zero digit
+          lastDig = p - 1;
+          while (*lastDig == '0') --lastDig;
+          if (lastDig == dot) {
+            --lastDig;
+            while (*lastDig == '0') --lastDig;
+          }
+          if (lastDig < eom)
+            lastDig = NULL;
+        }
+        goto mantissa_done;
+      }
+    }
+    // non-digit
+    if (peekc(p, last) != dotC) {
+      eom  = p;
+      if (mnt==0) {
+        // Check for various non-common possibilities : illegal strings, inf, nan, hexadecimal floating-point
+        // check if there were digits
+        if (p==str) { // there were no digits
+          uint64_t ret = 0;
+          if (effDot == 0) {
+            // look for Inf/Nan
+            if (hasChars(p, last, 3) && is_case_insensitively_equal(p, "INF", 3)) {
+              ret = uINF;
+              p += 3; // "inf" found, but it could be "infinity"
+              if (hasChars(p, last, 5) && is_case_insensitively_equal(p, "INITY", 5))
+                p += 5;
+            } else if (hasChars(p, last, 3) && is_case_insensitively_equal(p, "NAN", 3)) {
+              ret = uNaN;
+              p += 3;
+              // optional "(n-char-sequence)", C99 7.20.1.3
+              const char* q = p;
+              if (peekc(q, last) == '(') {
+                char c;
+                do c = peekc(++q, last);
+                while ((c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c == '_');
+                if (c == ')')
+                  p = q + 1;
+              }
+            }
+          }
+          if (ret == 0)
+            return NULL; // not a number
+          STATS_INC(nInfNan);
+          dst->mnt     = 0;
+          dst->signBit = ret | signBit;
+          return p;
+        } else if (fmt == 0 && p-str == 1 && effDot == 0 && (peekc(p, last) == 'X' || peekc(p, last) == 'x')) {
+          // "0x" prefix - possibly, hexadecimal floating-point
+          const char* hexstr = p + 1; // the 1st digit of hexadecimal mantissa
+          if (peekc(hexstr, last) == dotC) { // dot found before the 1st digit
+            ++hexstr;
+            effDot = hexstr; // record the next position, when dot found before the end of mnt
+            dotC = '0';
+          }
+          const char* hexEnd = parseHexMnt(hexstr, last, dotC, &mnt, &eom, &dot, &effDot);
+          if (hexEnd) {
+            p = hexEnd;
+            hexFloat = true;
+          } else { // there were no digits so input is not a hexadecimal floating-point
+            effDot = NULL; // roll back parsing state
+          }
+        }
+      }
+      break;
+    }
+    // dot found
+    effDot = p + 1; // record the next position, when dot found before the end of mnt
+    dotC = '0';
+    ++p;
+  }
+  mantissa_done:
+
+  if (p-str >= INPLEN_MAX)
+    return NULL; // input too long
+
+  // parse part of the string after last digit of mantissa
+  if (!effDot) // there were no dot
+    effDot = p;
+  int decExp = (int)(effDot - eom);
+  int binExp = decExp*4;
+
+  const char* ret_end = p;
+  bool exponentCharFound = false;
+  bool exponentFound = false;
+  switch (peekc(p, last)) {
+    case 'e':
+    case 'E':
+      // decimal exponent
+      exponentCharFound = fmt == 0 || (fmt & MY_CHARS_FORMAT_SCIENTIFIC);
+      break;
+
+    case 'p':
+    case 'P':
+      // binary  exponent
+      exponentCharFound = hexFloat;
+      break;
+
+    default:
+      break;
+  }
+
+  if (exponentCharFound) {
+    ++p;
+    // process sign
+    char expNeg = peekc(p, last);
+    switch (expNeg) {
+      case '+':
+      case '-':
+        ++p;
+        break;
+      default:
+        break;
+    }
+    if ((unsigned char)(peekc(p, last) - '0') <= 9) { // exponent present
+      // accumulate decExp or binExp
+      int expAcc = 0;
+      for (;;) {
+        unsigned dig = (unsigned char)peekc(p, last) - '0';
+        if (dig > 9)
+          break;
+        ++p;
+        if (LIKELY(expAcc < INPLEN_MAX*2))
+          expAcc = expAcc * 10 + dig;
+      }
+      if (expNeg=='-')
+        expAcc = -expAcc;
+      decExp += expAcc;
+      binExp += expAcc;
+      ret_end = p;
+      exponentFound = true;
+    }
+  }
+  if ((fmt & (MY_CHARS_FORMAT_FIXED|MY_CHARS_FORMAT_HEX)) == 0 && fmt != 0 && !exponentFound)
+    return NULL; // from_chars() scientific format requires exponent
+
+  dst->mnt      = mnt;
+  dst->eom      = eom;
+  dst->lastDig  = lastDig;
+  dst->dot      = dot;
+  dst->decExp   = decExp;
+  dst->binExp   = binExp;
+  dst->hexFloat = hexFloat;
+  dst->signBit  = signBit;
+  STATS_ADD(nHex, hexFloat);
+  return ret_end;
+}
+
+#endif // MY_STRTOD_PARSE_H
@@ -0,0 +1,34 @@
+#ifndef MY_STRTOD_STATS_H
+#define MY_STRTOD_STATS_H
+
+// Counters of decision points of my_strtod.c and my_strtod99.c.
+// Compiled into the engines only with -DMY_STRTOD_STATS, otherwise the engines contain no trace of them.
+// Counters are per thread, the functions below access counters of the calling thread.
+
+#include <stdint.h>
+
+typedef struct {
+  uint64_t nCalls;     // conversions, including illegal strings
+  uint64_t nInfNan;    // "inf", "infinity" or "nan" (my_strtod99.c)
+  uint64_t nHex;       // hexadecimal floating-point (my_strtod99.c)
+  uint64_t nOverUnder; // decimal exponent out of range, result is decided without calculation
+  uint64_t nExact;     // integer or hexadecimal converted by clz and shift (my_strtod99.c)
+  uint64_t nFpuFast;   // Clinger's fast path on hardware FPU (my_strtod99.c)
+  uint64_t nQuickDone; // quickCore() result is final
+  uint64_t nSlow;      // slow path entered: compareSrcWithMidpoint() / compareSrcWithThreshold()
+  uint64_t nSlowInt;   // slow path resolved before the loop over fractional digits
+  uint64_t nSlowFrac;  // slow path resolved in the loop over fractional digits
+} my_strtod_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void my_strtod_stats_get(my_strtod_stats_t* dst); // snapshot
+void my_strtod_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MY_STRTOD_STATS_H
@@ -0,0 +1,426 @@
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <fenv.h>
+#include <locale.h>
+
+// nl_langinfo() is used when system headers declare it, see my_strtod99.c
+#if !defined(_WIN32) && !defined(MY_STRTOD_NO_LANGINFO) && ((defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L) \
+  || (defined(_XOPEN_SOURCE) && _XOPEN_SOURCE >= 700) || defined(__APPLE__))
+#define MY_STRTOD_LANGINFO 1
+#include <langinfo.h>
+#endif
+
+#ifdef __GNUC__
+#define LIKELY(x)       __builtin_expect((x),1)
+#define UNLIKELY(x)     __builtin_expect((x),0)
+#define ALWAYS_INLINE   inline __attribute__((always_inline))
+#define NOINLINE        __attribute__((noinline))
+#else
+#define LIKELY(x)       x
+#define UNLIKELY(x)     x
+#define ALWAYS_INLINE   __forceinline
+#define NOINLINE        __declspec(noinline)
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+static __inline int __builtin_clzll(uint64_t x) {
+  unsigned long iMsb;
+  _BitScanReverse64(&iMsb, x);
+  return 63 - iMsb;
+}
+#endif
+
+// my_strtof() - correctly rounded conversion of decimal or hexadecimal string to binary32.
+// The same approach as my_strtod99.c: quick conversion with 64-bit mantissa that produces lower
+// and upper estimates, and, in rare cases when estimates round to different binary32 numbers,
+// exact comparison of the source string with the threshold between them.
+// The string is parsed by the parser of my_strtod99.c.
+#include "my_strtod_parse.h"
+
+enum {
+  MNT_DIGITS = 20,     // maximal number of decimal digits of mnt < 2**64
+  // Range of decimal exponents of mnt that require conversion.
+  // mnt*10**(POW10_MIN-1) < 10**(MNT_DIGITS+POW10_MIN-1) = 10**-46 < 2**-150, i.e. smaller values underflow
+  // mnt*10**(POW10_MAX+1) >= 10**(POW10_MAX+1) > FLT_MAX, i.e. bigger values overflow
+  POW10_MIN = -65,
+  POW10_MAX =  38,
+};
+
+const static uint64_t pow10tab[POW10_MAX-POW10_MIN+1] = { // 10**k * 2**(63-floor(k*log2(10))), truncated
+  0x86ccbb52ea94baea, // 10**(-65) * 2**( 279)
+  0xa87fea27a539e9a5, // 10**(-64) * 2**( 276)
+  0xd29fe4b18e88640e, // 10**(-63) * 2**( 273)
+  0x83a3eeeef9153e89, // 10**(-62) * 2**( 269)
+  0xa48ceaaab75a8e2b, // 10**(-61) * 2**( 266)
+  0xcdb02555653131b6, // 10**(-60) * 2**( 263)
+  0x808e17555f3ebf11, // 10**(-59) * 2**( 259)
+  0xa0b19d2ab70e6ed6, // 10**(-58) * 2**( 256)
+  0xc8de047564d20a8b, // 10**(-57) * 2**( 253)
+  0xfb158592be068d2e, // 10**(-56) * 2**( 250)
+  0x9ced737bb6c4183d, // 10**(-55) * 2**( 246)
+  0xc428d05aa4751e4c, // 10**(-54) * 2**( 243)
+  0xf53304714d9265df, // 10**(-53) * 2**( 240)
+  0x993fe2c6d07b7fab, // 10**(-52) * 2**( 236)
+  0xbf8fdb78849a5f96, // 10**(-51) * 2**( 233)
+  0xef73d256a5c0f77c, // 10**(-50) * 2**( 230)
+  0x95a8637627989aad, // 10**(-49) * 2**( 226)
+  0xbb127c53b17ec159, // 10**(-48) * 2**( 223)
+  0xe9d71b689dde71af, // 10**(-47) * 2**( 220)
+  0x9226712162ab070d, // 10**(-46) * 2**( 216)
+  0xb6b00d69bb55c8d1, // 10**(-45) * 2**( 213)
+  0xe45c10c42a2b3b05, // 10**(-44) * 2**( 210)
+  0x8eb98a7a9a5b04e3, // 10**(-43) * 2**( 206)
+  0xb267ed1940f1c61c, // 10**(-42) * 2**( 203)
+  0xdf01e85f912e37a3, // 10**(-41) * 2**( 200)
+  0x8b61313bbabce2c6, // 10**(-40) * 2**( 196)
+  0xae397d8aa96c1b77, // 10**(-39) * 2**( 193)
+  0xd9c7dced53c72255, // 10**(-38) * 2**( 190)
+  0x881cea14545c7575, // 10**(-37) * 2**( 186)
+  0xaa242499697392d2, // 10**(-36) * 2**( 183)
+  0xd4ad2dbfc3d07787, // 10**(-35) * 2**( 180)
+  0x84ec3c97da624ab4, // 10**(-34) * 2**( 176)
+  0xa6274bbdd0fadd61, // 10**(-33) * 2**( 173)
+  0xcfb11ead453994ba, // 10**(-32) * 2**( 170)
+  0x81ceb32c4b43fcf4, // 10**(-31) * 2**( 166)
+  0xa2425ff75e14fc31, // 10**(-30) * 2**( 163)
+  0xcad2f7f5359a3b3e, // 10**(-29) * 2**( 160)
+  0xfd87b5f28300ca0d, // 10**(-28) * 2**( 157)
+  0x9e74d1b791e07e48, // 10**(-27) * 2**( 153)
+  0xc612062576589dda, // 10**(-26) * 2**( 150)
+  0xf79687aed3eec551, // 10**(-25) * 2**( 147)
+  0x9abe14cd44753b52, // 10**(-24) * 2**( 143)
+  0xc16d9a0095928a27, // 10**(-23) * 2**( 140)
+  0xf1c90080baf72cb1, // 10**(-22) * 2**( 137)
+  0x971da05074da7bee, // 10**(-21) * 2**( 133)
+  0xbce5086492111aea, // 10**(-20) * 2**( 130)
+  0xec1e4a7db69561a5, // 10**(-19) * 2**( 127)
+  0x9392ee8e921d5d07, // 10**(-18) * 2**( 123)
+  0xb877aa3236a4b449, // 10**(-17) * 2**( 120)
+  0xe69594bec44de15b, // 10**(-16) * 2**( 117)
+  0x901d7cf73ab0acd9, // 10**(-15) * 2**( 113)
+  0xb424dc35095cd80f, // 10**(-14) * 2**( 110)
+  0xe12e13424bb40e13, // 10**(-13) * 2**( 107)
+  0x8cbccc096f5088cb, // 10**(-12) * 2**( 103)
+  0xafebff0bcb24aafe, // 10**(-11) * 2**( 100)
+  0xdbe6fecebdedd5be, // 10**(-10) * 2**(  97)
+  0x89705f4136b4a597, // 10**( -9) * 2**(  93)
+  0xabcc77118461cefc, // 10**( -8) * 2**(  90)
+  0xd6bf94d5e57a42bc, // 10**( -7) * 2**(  87)
+  0x8637bd05af6c69b5, // 10**( -6) * 2**(  83)
+  0xa7c5ac471b478423, // 10**( -5) * 2**(  80)
+  0xd1b71758e219652b, // 10**( -4) * 2**(  77)
+  0x83126e978d4fdf3b, // 10**( -3) * 2**(  73)
+  0xa3d70a3d70a3d70a, // 10**( -2) * 2**(  70)
+  0xcccccccccccccccc, // 10**( -1) * 2**(  67)
+  0x8000000000000000, // 10**(  0) * 2**(  63)
+  0xa000000000000000, // 10**(  1) * 2**(  60)
+  0xc800000000000000, // 10**(  2) * 2**(  57)
+  0xfa00000000000000, // 10**(  3) * 2**(  54)
+  0x9c40000000000000, // 10**(  4) * 2**(  50)
+  0xc350000000000000, // 10**(  5) * 2**(  47)
+  0xf424000000000000, // 10**(  6) * 2**(  44)
+  0x9896800000000000, // 10**(  7) * 2**(  40)
+  0xbebc200000000000, // 10**(  8) * 2**(  37)
+  0xee6b280000000000, // 10**(  9) * 2**(  34)
+  0x9502f90000000000, // 10**( 10) * 2**(  30)
+  0xba43b74000000000, // 10**( 11) * 2**(  27)
+  0xe8d4a51000000000, // 10**( 12) * 2**(  24)
+  0x9184e72a00000000, // 10**( 13) * 2**(  20)
+  0xb5e620f480000000, // 10**( 14) * 2**(  17)
+  0xe35fa931a0000000, // 10**( 15) * 2**(  14)
+  0x8e1bc9bf04000000, // 10**( 16) * 2**(  10)
+  0xb1a2bc2ec5000000, // 10**( 17) * 2**(   7)
+  0xde0b6b3a76400000, // 10**( 18) * 2**(   4)
+  0x8ac7230489e80000, // 10**( 19) * 2**(   0)
+  0xad78ebc5ac620000, // 10**( 20) * 2**(  -3)
+  0xd8d726b7177a8000, // 10**( 21) * 2**(  -6)
+  0x878678326eac9000, // 10**( 22) * 2**( -10)
+  0xa968163f0a57b400, // 10**( 23) * 2**( -13)
+  0xd3c21bcecceda100, // 10**( 24) * 2**( -16)
+  0x84595161401484a0, // 10**( 25) * 2**( -20)
+  0xa56fa5b99019a5c8, // 10**( 26) * 2**( -23)
+  0xcecb8f27f4200f3a, // 10**( 27) * 2**( -26)
+  0x813f3978f8940984, // 10**( 28) * 2**( -30)
+  0xa18f07d736b90be5, // 10**( 29) * 2**( -33)
+  0xc9f2c9cd04674ede, // 10**( 30) * 2**( -36)
+  0xfc6f7c4045812296, // 10**( 31) * 2**( -39)
+  0x9dc5ada82b70b59d, // 10**( 32) * 2**( -43)
+  0xc5371912364ce305, // 10**( 33) * 2**( -46)
+  0xf684df56c3e01bc6, // 10**( 34) * 2**( -49)
+  0x9a130b963a6c115c, // 10**( 35) * 2**( -53)
+  0xc097ce7bc90715b3, // 10**( 36) * 2**( -56)
+  0xf0bdc21abb48db20, // 10**( 37) * 2**( -59)
+  0x96769950b50d88f4, // 10**( 38) * 2**( -63)
+};
+
+static const uint32_t uINF    = (uint32_t)255 << 23;
+static const uint32_t uFLTMAX = ((uint32_t)255 << 23) - 1;
+static float u2f(uint32_t x) {
+  float y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
+static double u2d(uint64_t x) {
+  double y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
+// translate up/down rounding modes to toward zero/away from zero (represented by FE_UPWARD)
+static int effRoundingMode(int roundingMode, uint64_t signBit)
+{
+  switch (roundingMode) {
+    case FE_DOWNWARD:
+      return signBit ? FE_UPWARD : FE_TOWARDZERO;
+    case FE_UPWARD:
+      return signBit ? FE_TOWARDZERO : FE_UPWARD;
+    default:
+      return roundingMode;
+  }
+}
+
+// Round r * 2**(e2-63), where r >= 2**63, to binary32 bit pattern, sign not included
+static uint32_t roundToFloat(uint64_t r, int e2, int roundingMode)
+{
+  int be = e2 + 127; // biased exponent
+  if (be > 254)
+    return roundingMode == FE_TOWARDZERO ? uFLTMAX : uINF;
+
+  int rsh = 64-24; // # of bits below LS bit of binary32 mantissa
+  if (be < 1) {
+    // subnormal
+    rsh += 1 - be;
+    be = 1;
+  }
+  uint32_t res = 0;
+  uint64_t tail = 1; // all bits of r are far below 0.5 ULP
+  if (rsh < 64) {
+    res  = (uint32_t)(r >> rsh);
+    tail = r << (64 - rsh);
+  } else if (rsh == 64) {
+    tail = r;
+  }
+  res += (uint32_t)(be - 1) << 23; // implied '1' of normal numbers is added to exponent field
+  if (roundingMode == FE_TONEAREST) {
+    tail |= (res & 1);                  // break tie to even
+    res += tail > ((uint64_t)1 << 63);  // round to nearest
+  } else if (roundingMode == FE_UPWARD) {
+    res += (tail != 0);                 // round up
+  }
+  return res;
+}
+
+// Convert parsed source with non-zero mantissa to binary32 bit pattern, sign not included
+// *done = false indicates that the result can be 1 ULP below correctly rounded value
+// and has to be checked with slowCvt()
+static uint32_t quickCore(const parse_t* src, int roundingMode, bool* done)
+{
+  *done = true;
+  const uint64_t mnt = src->mnt;
+  const int lz = __builtin_clzll(mnt);
+  uint64_t r = mnt << lz;
+  if (src->hexFloat)
+    return roundToFloat(r, src->binExp + 63 - lz, roundingMode); // exact, sticky bit is in LS bit of mnt
+
+  const int decExp = src->decExp;
+  if (decExp > POW10_MAX)
+    return roundingMode == FE_TOWARDZERO ? uFLTMAX : uINF; // >= 10**39
+  if (decExp < POW10_MIN)
+    return roundingMode == FE_UPWARD ? 1 : 0; // < 10**-46
+
+  // decExp range [POW10_MIN:POW10_MAX]
+  // r*pow10tab[] is a lower estimate of the result. Its error comes from truncation of pow10tab[] and of the product,
+  // both below 1 in units of LS bit of the upper half of product, and from digits, that did not fit in mnt.
+  // In the latter case mnt > 10**18, so r < (mnt+1)<<lz < r + 2**4
+  uint64_t f = pow10tab[decExp - POW10_MIN];
+  uint64_t hi, lo;
+#ifdef _MSC_VER
+  lo = _umul128(r, f, &hi);
+#else
+  unsigned __int128 prod = (unsigned __int128)r * f;
+  hi = (uint64_t)(prod >> 64);
+  lo = (uint64_t)prod;
+#endif
+  int e2 = 64 + ((decExp*217706) >> 16) - lz; // (decExp*217706) >> 16 = floor(decExp*log2(10))
+  uint64_t err = src->lastDig ? 2+16 : 2;
+  if ((int64_t)hi >= 0) {
+    // normalize
+    hi = (hi << 1) | (lo >> 63);
+    e2  -= 1;
+    err *= 2;
+  }
+  uint32_t res = roundToFloat(hi, e2, roundingMode);
+  if (UNLIKELY(hi + err < hi || roundToFloat(hi + err, e2, roundingMode) != res))
+    *done = false; // upper estimate rounds differently
+  return res;
+}
+
+// dst = dst * y, where dst is little-endian number of *nwords 32-bit words
+static void mp_mulw(uint32_t dst[], int* nwords, uint32_t y)
+{
+  uint64_t acc = 0;
+  int n = *nwords;
+  for (int i = 0; i < n; ++i) {
+    acc += (uint64_t)dst[i] * y;
+    dst[i] = (uint32_t)acc;
+    acc >>= 32;
+  }
+  if (acc)
+    dst[(*nwords)++] = (uint32_t)acc;
+}
+
+// dst = dst / y, return remainder
+static uint32_t mp_divw(uint32_t dst[], int* nwords, uint32_t y)
+{
+  uint64_t rem = 0;
+  for (int i = *nwords-1; i >= 0; --i) {
+    rem = (rem << 32) | dst[i];
+    dst[i] = (uint32_t)(rem / y);
+    rem %= y;
+  }
+  while (*nwords > 0 && dst[*nwords-1] == 0)
+    --(*nwords);
+  return (uint32_t)rem;
+}
+
+// Compare source with threshold between u and next binary32 number:
+// u+0.5ULP for rounding to nearest, u+1ULP for rounding toward zero, u for rounding away from zero
+// return -1,0,+1 when source string respectively <, = or > of the threshold
+static int compareSrcWithThreshold(const parse_t* src, uint32_t u, int roundingMode)
+{
+  // threshold = thr*2**binExp
+  uint32_t be  = u >> 23;
+  uint32_t thr = u & (((uint32_t)1 << 23) - 1);
+  int binExp = (be ? (int)be : 1) - 127 - 23;
+  if (be)
+    thr |= (uint32_t)1 << 23;
+  if (roundingMode == FE_TONEAREST) {
+    thr = thr*2 + 1;
+    binExp -= 1;
+  } else if (roundingMode == FE_TOWARDZERO) {
+    thr += 1;
+  }
+
+  // convert threshold to decimal integer w, threshold = w*10**decExp
+  // Biggest w = (2**25)*5**150 < 2**374
+  enum { NWORDS = 12 };
+  uint32_t w[NWORDS] = { thr };
+  int nw = 1;
+  int decExp = 0;
+  if (binExp > 0) {
+    for (; binExp > 31; binExp -= 31)
+      mp_mulw(w, &nw, (uint32_t)1 << 31);
+    mp_mulw(w, &nw, (uint32_t)1 << binExp);
+  } else if (binExp < 0) {
+    decExp = binExp;
+    for (; binExp < -13; binExp += 13)
+      mp_mulw(w, &nw, 1220703125u); // 5**13
+    uint32_t pow5 = 1;
+    for (; binExp < 0; ++binExp)
+      pow5 *= 5;
+    mp_mulw(w, &nw, pow5);
+  }
+
+  // decimal digits of w
+  char buf[NWORDS*10+9];
+  char* bufEnd = &buf[sizeof(buf)];
+  char* thrDig = bufEnd;
+  while (nw > 0) {
+    uint32_t rem = mp_divw(w, &nw, 1000000000u);
+    for (int i = 0; i < 9; ++i) {
+      *--thrDig = (char)('0' + rem % 10);
+      rem /= 10;
+    }
+  }
+  while (thrDig != bufEnd && *thrDig == '0')
+    ++thrDig;
+  if (thrDig == bufEnd)
+    return 1; // threshold is zero
+
+  // decimal digits of mnt. Source digits are followed by digits in range [eom:lastDig], when lastDig != NULL
+  char mntBuf[MNT_DIGITS];
+  char* mntEnd = &mntBuf[MNT_DIGITS];
+  char* mntDig = mntEnd;
+  for (uint64_t m = src->mnt; m != 0; m /= 10)
+    *--mntDig = (char)('0' + m % 10);
+
+  // source = 0.mntDig*10**srcExp, threshold = 0.thrDig*10**thrExp
+  // Both have non-zero leading digit
+  int srcExp = src->decExp + (int)(mntEnd - mntDig);
+  int thrExp = decExp + (int)(bufEnd - thrDig);
+  if (srcExp != thrExp)
+    return srcExp > thrExp ? 1 : -1;
+
+  const char* p    = mntDig;
+  const char* end  = mntEnd;
+  const char* tail = src->lastDig ? src->eom : NULL;
+  for (; thrDig != bufEnd; ++thrDig) {
+    if (p == end && tail) {
+      p    = tail;
+      end  = src->lastDig + 1;
+      tail = NULL;
+    }
+    while (p != end && (unsigned char)(*p - '0') > 9)
+      ++p; // skip dot
+    char c = p != end ? *p++ : '0';
+    if (c != *thrDig)
+      return c > *thrDig ? 1 : -1;
+  }
+  if (tail)
+    return 1; // non-zero digit at lastDig is beyond the threshold
+  for (; p != end; ++p) {
+    if ((unsigned char)(*p - '1') <= 8)
+      return 1; // non-zero digit beyond the threshold
+  }
+  return 0;
+}
+
+// Blitzkrieg didn't work, let's do it slowly
+static NOINLINE uint32_t slowCvt(const parse_t* src, uint32_t res, int roundingMode)
+{
+  int cmp = compareSrcWithThreshold(src, res, roundingMode);
+  if (roundingMode == FE_TONEAREST) {
+    cmp |= res & 1;   // break tie to even
+    res += (cmp > 0);
+  } else if (roundingMode == FE_UPWARD) {
+    res += (cmp > 0);
+  } else {
+    res += (cmp >= 0);
+  }
+  return res;
+}
+
+// Decimal point character of the current locale of the calling thread
+static char decimalPoint(void)
+{
+#ifdef MY_STRTOD_LANGINFO
+  return nl_langinfo(RADIXCHAR)[0];
+#else
+  return localeconv()->decimal_point[0];
+#endif
+}
+
+float my_strtof(const char* str, char** str_end)
+{
+  parse_t prs;
+  const char* endp = parseSrc(&prs, str, NULL, decimalPoint(), 0);
+  if (str_end)
+    *str_end = (char*)(endp ? endp : str);
+  if (!endp)
+    return 0;
+
+  // Convert to floating point
+  if (prs.mnt == 0)
+    return (float)u2d(prs.signBit); // signed zero, Inf or NaN, exactly representable as binary32
+
+  int roundingMode = effRoundingMode(fegetround(), prs.signBit);
+  bool done;
+  uint32_t res = quickCore(&prs, roundingMode, &done);
+  if (UNLIKELY(!done))
+    res = slowCvt(&prs, res, roundingMode);
+  return u2f(res+(uint32_t)(prs.signBit >> 32));
+}
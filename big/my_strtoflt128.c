@@ -0,0 +1,853 @@
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <fenv.h>
+#include <locale.h>
+
+// nl_langinfo() is used when system headers declare it, see my_strtod99.c
+#if !defined(_WIN32) && !defined(MY_STRTOD_NO_LANGINFO) && ((defined(_POSIX_C_SOURCE) && _POSIX_C_SOURCE >= 200809L) \
+  || (defined(_XOPEN_SOURCE) && _XOPEN_SOURCE >= 700) || defined(__APPLE__))
+#define MY_STRTOD_LANGINFO 1
+#include <langinfo.h>
+#endif
+
+// gcc/clang only: relies on __float128 and unsigned __int128
+#define LIKELY(x)       __builtin_expect((x),1)
+#define UNLIKELY(x)     __builtin_expect((x),0)
+#define NOINLINE        __attribute__((noinline))
+
+typedef unsigned __int128 uint128_t;
+
+// my_strtoflt128() - correctly rounded conversion of decimal or hexadecimal string to binary128 (__float128).
+// The same approach as my_strtod99.c and my_strtof.c: quick conversion with 128-bit mantissa that produces lower
+// and upper estimates, and, in rare cases when estimates round to different binary128 numbers,
+// exact comparison of the source string with the threshold between them.
+
+enum {
+  INPLEN_MAX = 100000, // maximal length of mantissa part of legal input string, not including leading whitespace characters and sign
+  MNT_DIGITS = 38,     // maximal number of significant decimal digits accumulated in mnt. 10**38 < 2**127
+  // Range of decimal exponents of mnt that require conversion.
+  // mnt*10**POW10_MIN < 10**(MNT_DIGITS+POW10_MIN) = 10**-4965 < 2**-16494, i.e. smaller values underflow
+  // mnt*10**POW10_MAX >= 10**POW10_MAX, 10**(POW10_MAX+1) > FLT128_MAX, i.e. bigger values overflow
+  POW10_MIN = -5003,
+  POW10_MAX =  4932,
+  // 10**k = 10**(kH*POW10_FINE) * 10**kL, where 0 <= kL < POW10_FINE
+  POW10_FINE = 56, // 5**55 < 2**128, so all fine powers are exact
+  POW10_COARSE_MIN = -90, // floor(POW10_MIN/POW10_FINE)
+  POW10_COARSE_MAX =  88, // floor(POW10_MAX/POW10_FINE)
+};
+
+const static uint64_t pow5tab[POW10_FINE][2] = { // 5**k * 2**(127-floor(k*log2(5))), exact. {LS word, MS word}
+  { 0x0000000000000000, 0x8000000000000000 }, // 5**0
+  { 0x0000000000000000, 0xa000000000000000 }, // 5**1
+  { 0x0000000000000000, 0xc800000000000000 }, // 5**2
+  { 0x0000000000000000, 0xfa00000000000000 }, // 5**3
+  { 0x0000000000000000, 0x9c40000000000000 }, // 5**4
+  { 0x0000000000000000, 0xc350000000000000 }, // 5**5
+  { 0x0000000000000000, 0xf424000000000000 }, // 5**6
+  { 0x0000000000000000, 0x9896800000000000 }, // 5**7
+  { 0x0000000000000000, 0xbebc200000000000 }, // 5**8
+  { 0x0000000000000000, 0xee6b280000000000 }, // 5**9
+  { 0x0000000000000000, 0x9502f90000000000 }, // 5**10
+  { 0x0000000000000000, 0xba43b74000000000 }, // 5**11
+  { 0x0000000000000000, 0xe8d4a51000000000 }, // 5**12
+  { 0x0000000000000000, 0x9184e72a00000000 }, // 5**13
+  { 0x0000000000000000, 0xb5e620f480000000 }, // 5**14
+  { 0x0000000000000000, 0xe35fa931a0000000 }, // 5**15
+  { 0x0000000000000000, 0x8e1bc9bf04000000 }, // 5**16
+  { 0x0000000000000000, 0xb1a2bc2ec5000000 }, // 5**17
+  { 0x0000000000000000, 0xde0b6b3a76400000 }, // 5**18
+  { 0x0000000000000000, 0x8ac7230489e80000 }, // 5**19
+  { 0x0000000000000000, 0xad78ebc5ac620000 }, // 5**20
+  { 0x0000000000000000, 0xd8d726b7177a8000 }, // 5**21
+  { 0x0000000000000000, 0x878678326eac9000 }, // 5**22
+  { 0x0000000000000000, 0xa968163f0a57b400 }, // 5**23
+  { 0x0000000000000000, 0xd3c21bcecceda100 }, // 5**24
+  { 0x0000000000000000, 0x84595161401484a0 }, // 5**25
+  { 0x0000000000000000, 0xa56fa5b99019a5c8 }, // 5**26
+  { 0x0000000000000000, 0xcecb8f27f4200f3a }, // 5**27
+  { 0x4000000000000000, 0x813f3978f8940984 }, // 5**28
+  { 0x5000000000000000, 0xa18f07d736b90be5 }, // 5**29
+  { 0xa400000000000000, 0xc9f2c9cd04674ede }, // 5**30
+  { 0x4d00000000000000, 0xfc6f7c4045812296 }, // 5**31
+  { 0xf020000000000000, 0x9dc5ada82b70b59d }, // 5**32
+  { 0x6c28000000000000, 0xc5371912364ce305 }, // 5**33
+  { 0xc732000000000000, 0xf684df56c3e01bc6 }, // 5**34
+  { 0x3c7f400000000000, 0x9a130b963a6c115c }, // 5**35
+  { 0x4b9f100000000000, 0xc097ce7bc90715b3 }, // 5**36
+  { 0x1e86d40000000000, 0xf0bdc21abb48db20 }, // 5**37
+  { 0x1314448000000000, 0x96769950b50d88f4 }, // 5**38
+  { 0x17d955a000000000, 0xbc143fa4e250eb31 }, // 5**39
+  { 0x5dcfab0800000000, 0xeb194f8e1ae525fd }, // 5**40
+  { 0x5aa1cae500000000, 0x92efd1b8d0cf37be }, // 5**41
+  { 0xf14a3d9e40000000, 0xb7abc627050305ad }, // 5**42
+  { 0x6d9ccd05d0000000, 0xe596b7b0c643c719 }, // 5**43
+  { 0xe4820023a2000000, 0x8f7e32ce7bea5c6f }, // 5**44
+  { 0xdda2802c8a800000, 0xb35dbf821ae4f38b }, // 5**45
+  { 0xd50b2037ad200000, 0xe0352f62a19e306e }, // 5**46
+  { 0x4526f422cc340000, 0x8c213d9da502de45 }, // 5**47
+  { 0x9670b12b7f410000, 0xaf298d050e4395d6 }, // 5**48
+  { 0x3c0cdd765f114000, 0xdaf3f04651d47b4c }, // 5**49
+  { 0xa5880a69fb6ac800, 0x88d8762bf324cd0f }, // 5**50
+  { 0x8eea0d047a457a00, 0xab0e93b6efee0053 }, // 5**51
+  { 0x72a4904598d6d880, 0xd5d238a4abe98068 }, // 5**52
+  { 0x47a6da2b7f864750, 0x85a36366eb71f041 }, // 5**53
+  { 0x999090b65f67d924, 0xa70c3c40a64e6c51 }, // 5**54
+  { 0xfff4b4e3f741cf6d, 0xd0cf4b50cfe20765 }, // 5**55
+};
+
+const static uint64_t pow10coarse[POW10_COARSE_MAX-POW10_COARSE_MIN+1][2] = { // 10**(k*POW10_FINE) * 2**(127-floor(k*POW10_FINE*log2(10))), truncated
+  { 0xbf034c011f5000de, 0xb2d31bf022977fd8 }, // 10**(-5040)
+  { 0x2b55c9e70e00c557, 0xb6536903bf8f2bda }, // 10**(-4984)
+  { 0xbddb2dfde3f8a6e3, 0xb9e5428330737362 }, // 10**(-4928)
+  { 0x88227fdfc13ab53d, 0xbd89006346a9a34d }, // 10**(-4872)
+  { 0xe05fe4207ca3d508, 0xc13efc51ade7df64 }, // 10**(-4816)
+  { 0x3c55f3f947fef0e9, 0xc50791bd8dd72edb }, // 10**(-4760)
+  { 0x0915564d8ab057ee, 0xc8e31de056f89c19 }, // 10**(-4704)
+  { 0x801e38463183fc88, 0xccd1ffc6bba63e21 }, // 10**(-4648)
+  { 0xcfadf6b2aa7c4f43, 0xd0d49859d60d40a3 }, // 10**(-4592)
+  { 0x9e601e707a2c3488, 0xd4eb4a687c0253e8 }, // 10**(-4536)
+  { 0xa8edffdccfe4db4b, 0xd9167ab0c1965798 }, // 10**(-4480)
+  { 0xb17cd86e7fcece75, 0xdd568fe9ab559344 }, // 10**(-4424)
+  { 0x1151250681d59705, 0xe1abf2cd11206610 }, // 10**(-4368)
+  { 0x025a8e1e5dbb41d6, 0xe6170e21b2910457 }, // 10**(-4312)
+  { 0x66e849253e5da0c2, 0xea984ec57de69f13 }, // 10**(-4256)
+  { 0xf5a7800f23ef67b8, 0xef3023b80a732d93 }, // 10**(-4200)
+  { 0x0e85fc7f4edbd3ca, 0xf3defe25478e074a }, // 10**(-4144)
+  { 0x4268a54f70bd28c4, 0xf8a551706112897c }, // 10**(-4088)
+  { 0x5052e9289f0f2333, 0xfd83933eda772c0b }, // 10**(-4032)
+  { 0x01b02378a405b421, 0x813d1dc1f0c754d6 }, // 10**(-3976)
+  { 0xb782db1fc6aba49b, 0x83c4e245ed051dc1 }, // 10**(-3920)
+  { 0x4250be2eeba87d15, 0x86595584116caf3c }, // 10**(-3864)
+  { 0x3f1f93f1943ca9b6, 0x88fab70d8b44952a }, // 10**(-3808)
+  { 0x2c87f18b39478aa2, 0x8ba947b223e5783e }, // 10**(-3752)
+  { 0x4054f5360249ebd1, 0x8e6549867da7d11a }, // 10**(-3696)
+  { 0xc1187fa0c18adbbe, 0x912effea7015b2c5 }, // 10**(-3640)
+  { 0x4b4de34e0ebc3e06, 0x9406af8f83fd6265 }, // 10**(-3584)
+  { 0xac73f0226eff5ea1, 0x96ec9e7f9004839b }, // 10**(-3528)
+  { 0x2184706ea46a4c38, 0x99e11423765ec1d0 }, // 10**(-3472)
+  { 0xddadb80577b906bd, 0x9ce4594a044e0f1b }, // 10**(-3416)
+  { 0x60dbd8aa443b560f, 0x9ff6b82ef415d222 }, // 10**(-3360)
+  { 0x7401c6f091f87727, 0xa3187c82120dace6 }, // 10**(-3304)
+  { 0x4d5b32f713d7f476, 0xa649f36e8583e81a }, // 10**(-3248)
+  { 0xb4b39dd9ddb8d317, 0xa98b6ba23e2300c7 }, // 10**(-3192)
+  { 0xec41c1793d69d0d1, 0xacdd3555869159d1 }, // 10**(-3136)
+  { 0x3ca5a7540d9d56c9, 0xb03fa252bd05a815 }, // 10**(-3080)
+  { 0x92e1bc1fbb33f18d, 0xb3b305fe328e571f }, // 10**(-3024)
+  { 0xa908fd4a88728b6a, 0xb737b55e31cdde04 }, // 10**(-2968)
+  { 0x7c4c65d15c614c56, 0xbace07232df1c802 }, // 10**(-2912)
+  { 0xef84cc99cb4c5d17, 0xbe7653b01aae13e5 }, // 10**(-2856)
+  { 0xcfc147ade4843a24, 0xc230f522ee0a7fc2 }, // 10**(-2800)
+  { 0x4668677d5f46c29b, 0xc5fe475d4cd35cff }, // 10**(-2744)
+  { 0x474b3cb1fe1d6a7f, 0xc9dea80d6283a34c }, // 10**(-2688)
+  { 0xd6ea3b733029ef0b, 0xcdd276b6e582284f }, // 10**(-2632)
+  { 0x3736730a9e47fef8, 0xd1da14bc489025ea }, // 10**(-2576)
+  { 0x3d24e68dc1027246, 0xd5f5e5681a4b9285 }, // 10**(-2520)
+  { 0x742ab8f3864562c8, 0xda264df693ac3e30 }, // 10**(-2464)
+  { 0x8c119f3680212413, 0xde6bb59f56672cda }, // 10**(-2408)
+  { 0x43190b523f872b9c, 0xe2c6859f5c284230 }, // 10**(-2352)
+  { 0x2a0969bf88679396, 0xe7372943179706fc }, // 10**(-2296)
+  { 0x131565be33dda91a, 0xebbe0df0c8201ac5 }, // 10**(-2240)
+  { 0xccfb1cc2ef1f44de, 0xf05ba3330181c750 }, // 10**(-2184)
+  { 0x5f8385b3a882ff4c, 0xf5105ac3681f2716 }, // 10**(-2128)
+  { 0x166c15f456786c27, 0xf9dca895a3226409 }, // 10**(-2072)
+  { 0x6c656c3b1f2c9d91, 0xfec102e2857bc1f9 }, // 10**(-2016)
+  { 0xfa70b9a2ca60b004, 0x81def119b76837c8 }, // 10**(-1960)
+  { 0x6a22490e8e9ec98b, 0x8469e0b6f2b8bd9b }, // 10**(-1904)
+  { 0x69138459b0fa72d4, 0x87018eefb53c6325 }, // 10**(-1848)
+  { 0x6c83ad1260ff20f4, 0x89a63ba4c497b50e }, // 10**(-1792)
+  { 0xd82ef2860273de8d, 0x8c5827f711735b46 }, // 10**(-1736)
+  { 0x416d7f9ab1e67580, 0x8f17964dfc3961f2 }, // 10**(-1680)
+  { 0x56700866b85d57fe, 0x91e4ca5db93dbfec }, // 10**(-1624)
+  { 0x43cf71d5c4fd7868, 0x94c0092dd4ef9511 }, // 10**(-1568)
+  { 0x387898a6e22f821b, 0x97a9991fd8b3afc0 }, // 10**(-1512)
+  { 0x8f8857e875e7774e, 0x9aa1c1f6110c0dd0 }, // 10**(-1456)
+  { 0xa5c58d5f91a476d7, 0x9da8ccda75b341b5 }, // 10**(-1400)
+  { 0x6e1f7f1642ebaac8, 0xa0bf0465b455e921 }, // 10**(-1344)
+  { 0xfad2be1679765f27, 0xa3e4b4a65e97b76a }, // 10**(-1288)
+  { 0x800cfab80c4e2eb1, 0xa71a2b283c14fba6 }, // 10**(-1232)
+  { 0x850b0c5976b21027, 0xaa5fb6fbc115010b }, // 10**(-1176)
+  { 0x61363686961a41e5, 0xadb5a8bdaaa53051 }, // 10**(-1120)
+  { 0xc6f075c4b81fc72d, 0xb11c529ec0d87268 }, // 10**(-1064)
+  { 0xb4e4be5b6455ef96, 0xb494086bbfea00c3 }, // 10**(-1008)
+  { 0x24d256c540a50309, 0xb81d1f9569068d8e }, // 10**( -952)
+  { 0x6d4aa5b50bb5dc0d, 0xbbb7ef38bb827f2d }, // 10**( -896)
+  { 0x925624c0d7d93317, 0xbf64d0275747de70 }, // 10**( -840)
+  { 0x8e5a2e5116baf191, 0xc3241cf0094a8e70 }, // 10**( -784)
+  { 0xb0560c246f90e9e8, 0xc6f631e782d57096 }, // 10**( -728)
+  { 0x2ffff1289a804c5a, 0xcadb6d313c8736fc }, // 10**( -672)
+  { 0xa855e127113c887b, 0xced42ec885d9dbbe }, // 10**( -616)
+  { 0xe00bad8dfc0d8c8e, 0xd2e0d889c213fd60 }, // 10**( -560)
+  { 0xc654d07271e6c39f, 0xd701ce3bd387bf47 }, // 10**( -504)
+  { 0x84c663cee6b86e7c, 0xdb377599b6074244 }, // 10**( -448)
+  { 0xcb285ceb2fed040d, 0xdf82365c497b5453 }, // 10**( -392)
+  { 0xfd1b1b2308169b25, 0xe3e27a444d8d98b7 }, // 10**( -336)
+  { 0xd1b3400f8f9cff68, 0xe858ad248f5c22c9 }, // 10**( -280)
+  { 0xa4f8bf5635246428, 0xece53cec4a314ebd }, // 10**( -224)
+  { 0xdc44e6c3cb279ac1, 0xf18899b1bc3f8ca1 }, // 10**( -168)
+  { 0x4d4617b5ff4a16d5, 0xf64335bcf065d37d }, // 10**( -112)
+  { 0xeed6e2f0f0d56712, 0xfb158592be068d2e }, // 10**(  -56)
+  { 0x0000000000000000, 0x8000000000000000 }, // 10**(    0)
+  { 0xbff8f10e7a8921a4, 0x82818f1281ed449f }, // 10**(   56)
+  { 0x03e2cf6bc604ddb0, 0x850fadc09923329e }, // 10**(  112)
+  { 0x90fb44d2f05d0842, 0x87aa9aff79042286 }, // 10**(  168)
+  { 0x82bd6b70d99aaa6f, 0x8a5296ffe33cc92f }, // 10**(  224)
+  { 0xdb0b487b6423e1e8, 0x8d07e33455637eb2 }, // 10**(  280)
+  { 0x213a4f0aa5e8a7b1, 0x8fcac257558ee4e6 }, // 10**(  336)
+  { 0x1c306f5d1b0b5fdf, 0x929b7871de7f22b9 }, // 10**(  392)
+  { 0xa7ea9c8838ce9437, 0x957a4ae1ebf7f3d3 }, // 10**(  448)
+  { 0xbf1d49cacccd5e68, 0x9867806127ece4f4 }, // 10**(  504)
+  { 0x655494c5c95d77f2, 0x9b63610bb9243e46 }, // 10**(  560)
+  { 0x02e008393fd60b55, 0x9e6e366733f85561 }, // 10**(  616)
+  { 0x55e04dba4b3bd4dd, 0xa1884b69ade24964 }, // 10**(  672)
+  { 0x44b222741eb1ebbf, 0xa4b1ec80f47c84ad }, // 10**(  728)
+  { 0x1cf4a5c3bc09fa6f, 0xa7eb6799e8aec999 }, // 10**(  784)
+  { 0x3c4a575151b294dc, 0xab350c27feb90acc }, // 10**(  840)
+  { 0x870a8d87239d8f35, 0xae8f2b2ce3d5dbe9 }, // 10**(  896)
+  { 0xdd929f09c3eff5ac, 0xb1fa17404a30e5e8 }, // 10**(  952)
+  { 0x1931b583a9431d7e, 0xb5762497dbf17a9e }, // 10**( 1008)
+  { 0xe30db03e0f8dd286, 0xb903a90f561d25e2 }, // 10**( 1064)
+  { 0x9eb5cb19647508c5, 0xbca2fc30cc19f090 }, // 10**( 1120)
+  { 0x24bd4c00042ad125, 0xc054773d149bf26b }, // 10**( 1176)
+  { 0x7ea30dbd7ea479e3, 0xc418753460cdcca9 }, // 10**( 1232)
+  { 0x764f4cf916b4dece, 0xc7ef52defe87b751 }, // 10**( 1288)
+  { 0xbeb7fbdc1cbe8b37, 0xcbd96ed6466cf081 }, // 10**( 1344)
+  { 0xdce472c619aa3f63, 0xcfd7298db6cb9672 }, // 10**( 1400)
+  { 0xe47defc14a406e4f, 0xd3e8e55c3c1f43d0 }, // 10**( 1456)
+  { 0xb7157c60a24a0569, 0xd80f0685a81b2a81 }, // 10**( 1512)
+  { 0xfb0b98f6bbc4f0cb, 0xdc49f3445824e360 }, // 10**( 1568)
+  { 0xc6c6c1764e047e15, 0xe09a13d30c2dba62 }, // 10**( 1624)
+  { 0x87e8dcfc09dbc33a, 0xe4ffd276eedce658 }, // 10**( 1680)
+  { 0xb1a3642a8da3cf4f, 0xe97b9b89d001dab3 }, // 10**( 1736)
+  { 0x2d4070f33b21ab7b, 0xee0ddd84924ab88c }, // 10**( 1792)
+  { 0xa2bf0c63a814e04e, 0xf2b70909cd3fd35c }, // 10**( 1848)
+  { 0x08f13995cf9c2747, 0xf77790f0a48a45ce }, // 10**( 1904)
+  { 0x7a37993eb21444fa, 0xfc4fea4fd590b40a }, // 10**( 1960)
+  { 0xb7b1ada9cdeba84d, 0x80a046447e3d49f1 }, // 10**( 2016)
+  { 0x0cc6866c5d69b2cb, 0x8324f8aa08d7d411 }, // 10**( 2072)
+  { 0x7fe2b4308dcbf1a3, 0x85b64a659077660e }, // 10**( 2128)
+  { 0x1d73ef3eaac3c964, 0x88547abb1d8e5bd9 }, // 10**( 2184)
+  { 0x1e34291b1ef566c7, 0x8affca2bd1f88549 }, // 10**( 2240)
+  { 0x9e9383d73d486881, 0x8db87a7c1e56d873 }, // 10**( 2296)
+  { 0x9cc5ee51962c011a, 0x907eceba168949b3 }, // 10**( 2352)
+  { 0x413407cfeeac9743, 0x93530b43e5e2c129 }, // 10**( 2408)
+  { 0x7efa7d29c44e11b7, 0x963575ce63b6332d }, // 10**( 2464)
+  { 0x5a848859645d1c6f, 0x9926556bc8defe43 }, // 10**( 2520)
+  { 0x51edea897b34601f, 0x9c25f29286e9ddb6 }, // 10**( 2576)
+  { 0xb50008d92529e91f, 0x9f3497244186fca4 }, // 10**( 2632)
+  { 0xf09e780bcc8238d9, 0xa2528e74eaf101fc }, // 10**( 2688)
+  { 0x3a5828869701a165, 0xa580255203f84b47 }, // 10**( 2744)
+  { 0x8b231a70eb5444ce, 0xa8bdaa0a0064fa44 }, // 10**( 2800)
+  { 0xfa1bde1f473556a4, 0xac0b6c73d065f8cc }, // 10**( 2856)
+  { 0x7730e00421da4d55, 0xaf69bdf68fc6a740 }, // 10**( 2912)
+  { 0x7f959cb702329d14, 0xb2d8f1915ba88ca5 }, // 10**( 2968)
+  { 0x40c3a071220f5567, 0xb6595be34f821493 }, // 10**( 3024)
+  { 0x11c48d02b8326bd3, 0xb9eb5333aa272e9b }, // 10**( 3080)
+  { 0x566765461bd2f61b, 0xbd8f2f7a1ba47d6d }, // 10**( 3136)
+  { 0xb889018e4f6e9a52, 0xc1454a673cb9b1ce }, // 10**( 3192)
+  { 0xf85333a94848659f, 0xc50dff6d30c3aefc }, // 10**( 3248)
+  { 0x1a1aeae7cf8a9d3d, 0xc8e9abc872eb2bc1 }, // 10**( 3304)
+  { 0x12e29f09d9061609, 0xccd8ae88cf70ad84 }, // 10**( 3360)
+  { 0xdf7601457ca20b35, 0xd0db689a89f2f9b1 }, // 10**( 3416)
+  { 0xcbdcd02f23cc7690, 0xd4f23ccfb1916df5 }, // 10**( 3472)
+  { 0x44289dd21b589d7a, 0xd91d8fe9a3d019cc }, // 10**( 3528)
+  { 0x95aa118ec1d08317, 0xdd5dc8a2bf27f3f7 }, // 10**( 3584)
+  { 0x72c4d2cad73b0a7b, 0xe1b34fb846321d04 }, // 10**( 3640)
+  { 0xe20a88f1134f906d, 0xe61e8ff47461cda9 }, // 10**( 3696)
+  { 0xc7c91d5c341ed39d, 0xea9ff638c54554e1 }, // 10**( 3752)
+  { 0xf659ede2159a45ec, 0xef37f1886f4b6690 }, // 10**( 3808)
+  { 0x78d946bab954b82f, 0xf3e6f313130ef0ef }, // 10**( 3864)
+  { 0xc9b1474d8f89c269, 0xf8ad6e3fa030bd15 }, // 10**( 3920)
+  { 0x6b1d2745340e7b14, 0xfd8bd8b770cb469e }, // 10**( 3976)
+  { 0xf22e502fcdd4bca2, 0x81415538ce493bd5 }, // 10**( 4032)
+  { 0x7c1735fc3b813c8c, 0x83c92edf425b292d }, // 10**( 4088)
+  { 0x0367500a8e9a178f, 0x865db7a9ccd2839e }, // 10**( 4144)
+  { 0xc9ac50475e25293a, 0x88ff2f2bade74531 }, // 10**( 4200)
+  { 0x0879b2e5f6ee8b1c, 0x8badd636cc48b341 }, // 10**( 4256)
+  { 0x2f33c652bd12fab7, 0x8e69eee1f23f2be5 }, // 10**( 4312)
+  { 0xad6a6308a8e8b557, 0x9133bc8f2a130fe5 }, // 10**( 4368)
+  { 0x9dbaa465efe141a0, 0x940b83f23a55842a }, // 10**( 4424)
+  { 0x888c9ab2fc5b3437, 0x96f18b1742aad751 }, // 10**( 4480)
+  { 0xba00864671d1053f, 0x99e6196979b978f1 }, // 10**( 4536)
+  { 0x61d59d402aae4fea, 0x9ce977ba0ce3a0bd }, // 10**( 4592)
+  { 0x803c1cd864033781, 0x9ffbf04722750449 }, // 10**( 4648)
+  { 0xa28a151725a55e10, 0xa31dcec2fef14b30 }, // 10**( 4704)
+  { 0x5b8452af2302fe13, 0xa64f605b4e3352cd }, // 10**( 4760)
+  { 0x82b84cabc828bf93, 0xa990f3c09110c544 }, // 10**( 4816)
+  { 0x8d29dd5122e4278d, 0xace2d92db0390b59 }, // 10**( 4872)
+  { 0x58f8fde02c03a6c6, 0xb045626fb50a35e7 }, // 10**( 4928)
+};
+
+static const uint128_t uINF    = (uint128_t)0x7fff << 112;
+static const uint128_t uMAX    = ((uint128_t)0x7fff << 112) - 1;
+static const uint128_t uNaN    = ((uint128_t)0x7fff << 112) | ((uint128_t)1 << 111);
+
+typedef struct {
+  uint128_t   mnt;    // leading MNT_DIGITS significant decimal digits or leading hexadecimal digits of mantissa
+  const char* mntBeg; // 1st significant digit of decimal mantissa
+  const char* mntEnd; // end of decimal mantissa
+  int         nd;     // number of decimal digits in mnt
+  int         exp;    // decimal exponent or, for hexadecimal floating-point, binary exponent of mnt
+  bool        sticky; // there are non-zero digits beyond those accumulated in mnt
+  bool        hexFloat;
+  uint128_t   signBit;// sign bit of the result. When mnt==0 - bit pattern of the result (signed zero, Inf or NaN)
+} parse_t;
+
+static __float128 u2q(uint128_t x) {
+  __float128 y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
+static int clz128(uint128_t x) {
+  uint64_t hi = (uint64_t)(x >> 64);
+  return hi ? __builtin_clzll(hi) : 64 + __builtin_clzll((uint64_t)x);
+}
+
+// floor(k*log2(10)), exact for |k| < 10000
+static int floorLog2Pow10(int k) {
+  return (int)(((int64_t)k * 14267572527) >> 32);
+}
+
+static bool is_case_insensitively_equal(const char* x, const char* uppercaseRef, unsigned len) {
+  for (unsigned i = 0; i < len; ++i)
+    if (toupper(x[i]) != uppercaseRef[i])
+      return false;
+  return true;
+}
+
+static unsigned hexDigitValue(char c)
+{ // return value > 15 for non-hexadecimal characters
+  unsigned char uc = (unsigned char)c;
+  if (uc - '0' <= 9)
+    return uc - '0';
+  uc |= 0x20; // lower case
+  if (uc - 'a' <= 5)
+    return uc - 'a' + 10;
+  return 16;
+}
+
+// parse exponent part at p. Return end of exponent part or p when there is no exponent
+static const char* parseExponent(const char* p, char expC, int* exp)
+{
+  if ((*p | 0x20) != expC)
+    return p;
+  const char* q = p + 1;
+  char expNeg = *q;
+  if (expNeg == '+' || expNeg == '-')
+    ++q;
+  if ((unsigned char)(*q - '0') > 9)
+    return p;
+  int expAcc = 0;
+  for (;;) {
+    unsigned dig = (unsigned char)*q - '0';
+    if (dig > 9)
+      break;
+    ++q;
+    if (LIKELY(expAcc < INPLEN_MAX*2))
+      expAcc = expAcc * 10 + dig;
+  }
+  *exp += expNeg == '-' ? -expAcc : expAcc;
+  return q;
+}
+
+// Parse hexadecimal floating-point mantissa that starts at str, after "0x" prefix
+// Return end of the converted part of the string or NULL when there are no hexadecimal digits
+static const char* parseHex(parse_t* dst, const char* str, char dotC)
+{
+  const char* p = str;
+  const char* dot = NULL;
+  bool hasDigits = false;
+  uint128_t mnt = 0;
+  int exp = 0;
+  bool sticky = false;
+  for (;; ++p) {
+    unsigned dig = hexDigitValue(*p);
+    if (dig > 15) {
+      if (*p == dotC && !dot) {
+        dot = p;
+        continue;
+      }
+      break; // end of mantissa
+    }
+    hasDigits = true;
+    if (mnt < (uint128_t)1 << 120) {
+      mnt = mnt * 16 + dig;
+      exp -= dot ? 4 : 0;
+    } else {
+      sticky |= dig != 0;
+      exp += dot ? 0 : 4;
+    }
+  }
+  if (!hasDigits || p - str >= INPLEN_MAX)
+    return NULL;
+
+  p = parseExponent(p, 'p', &exp);
+  dst->mnt      = mnt;
+  dst->exp      = exp;
+  dst->sticky   = sticky;
+  dst->hexFloat = true;
+  return p;
+}
+
+// Parse source string and store the results in dst
+// Return end of the converted part of the string or NULL when no conversion can be performed
+static const char* parseSrc(parse_t* dst, const char* str, char dotC)
+{
+  // discard leading whitespace characters
+  while (isspace((unsigned char)*str)) ++str;
+
+  // process sign
+  char neg = *str;
+  if (neg == '+' || neg == '-')
+    ++str;
+  dst->signBit = (neg=='-') ? (uint128_t)1 << 127 : 0;
+
+  if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+    // "0x" prefix - possibly, hexadecimal floating-point
+    const char* p = parseHex(dst, &str[2], dotC);
+    if (p)
+      return p;
+  }
+
+  // accumulate mantissa
+  // The first 19 significant digits go to mnt0, the rest, up to MNT_DIGITS, to mnt1
+  const char* p = str;
+  const char* dot = NULL;
+  const char* mntBeg = NULL;
+  bool hasDigits = false;
+  uint64_t mnt0 = 0, mnt1 = 0;
+  int nd = 0;
+  int exp = 0;
+  bool sticky = false;
+  for (;; ++p) {
+    unsigned dig = (unsigned char)*p - '0';
+    if (dig > 9) {
+      if (*p == dotC && !dot) {
+        dot = p;
+        continue;
+      }
+      break; // end of mantissa
+    }
+    hasDigits = true;
+    if (nd < MNT_DIGITS) {
+      exp -= (dot != NULL);
+      if (nd < 19) {
+        if (mnt0 == 0) {
+          if (dig == 0)
+            continue; // leading zero
+          mntBeg = p;
+        }
+        mnt0 = mnt0 * 10 + dig;
+      } else {
+        mnt1 = mnt1 * 10 + dig;
+      }
+      ++nd;
+    } else {
+      sticky |= dig != 0;
+      exp += (dot == NULL);
+    }
+  }
+
+  if (!hasDigits) {
+    if (dot)
+      return NULL; // not a number
+    // look for Inf/Nan
+    uint128_t ret = 0;
+    if (is_case_insensitively_equal(p, "INF", 3)) {
+      ret = uINF;
+      p += 3; // "inf" found, but it could be "infinity"
+      if (is_case_insensitively_equal(p, "INITY", 5))
+        p += 5;
+    } else if (is_case_insensitively_equal(p, "NAN", 3)) {
+      ret = uNaN;
+      p += 3;
+      // optional "(n-char-sequence)"
+      const char* q = p;
+      if (*q == '(') {
+        char c;
+        do c = *++q;
+        while ((c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c == '_');
+        if (c == ')')
+          p = q + 1;
+      }
+    }
+    if (ret == 0)
+      return NULL; // not a number
+    dst->mnt      = 0;
+    dst->signBit |= ret;
+    return p;
+  }
+
+  if (p-str >= INPLEN_MAX)
+    return NULL; // input too long
+
+  uint128_t mnt = mnt0;
+  if (nd > 19) {
+    uint64_t pow10 = 1;
+    for (int i = 19; i < nd; ++i)
+      pow10 *= 10;
+    mnt = mnt * pow10 + mnt1;
+  }
+
+  dst->mntEnd = p;
+  p = parseExponent(p, 'e', &exp);
+  dst->mnt      = mnt;
+  dst->mntBeg   = mntBeg;
+  dst->nd       = nd;
+  dst->exp      = exp;
+  dst->sticky   = sticky;
+  dst->hexFloat = false;
+  return p;
+}
+
+// translate up/down rounding modes to toward zero/away from zero (represented by FE_UPWARD)
+static int effRoundingMode(int roundingMode, uint128_t signBit)
+{
+  switch (roundingMode) {
+    case FE_DOWNWARD:
+      return signBit ? FE_UPWARD : FE_TOWARDZERO;
+    case FE_UPWARD:
+      return signBit ? FE_TOWARDZERO : FE_UPWARD;
+    default:
+      return roundingMode;
+  }
+}
+
+// Round r * 2**(e2-127), where r >= 2**127, to binary128 bit pattern, sign not included
+static uint128_t roundToQuad(uint128_t r, int e2, int roundingMode)
+{
+  int be = e2 + 16383; // biased exponent
+  if (be > 32766)
+    return roundingMode == FE_TOWARDZERO ? uMAX : uINF;
+
+  int rsh = 128-113; // # of bits below LS bit of binary128 mantissa
+  if (be < 1) {
+    // subnormal
+    rsh += 1 - be;
+    be = 1;
+  }
+  uint128_t res = 0;
+  uint128_t tail = 1; // all bits of r are far below 0.5 ULP
+  if (rsh < 128) {
+    res  = r >> rsh;
+    tail = r << (128 - rsh);
+  } else if (rsh == 128) {
+    tail = r;
+  }
+  res += (uint128_t)(be - 1) << 112; // implied '1' of normal numbers is added to exponent field
+  if (roundingMode == FE_TONEAREST) {
+    tail |= (res & 1);                   // break tie to even
+    res += tail > ((uint128_t)1 << 127); // round to nearest
+  } else if (roundingMode == FE_UPWARD) {
+    res += (tail != 0);                  // round up
+  }
+  return res;
+}
+
+// Upper half of x*y, normalized, i.e. x*y = (*res)*2**(128-*nsh) + lower part, 2**127 <= *res < 2**128
+// x >= 2**127, y >= 2**127, y = {LS word, MS word}
+static uint128_t mulhi128(uint128_t x, const uint64_t y[2], int* nsh)
+{
+  uint64_t x0 = (uint64_t)x, x1 = (uint64_t)(x >> 64);
+  uint128_t p00 = (uint128_t)x0 * y[0];
+  uint128_t p01 = (uint128_t)x0 * y[1];
+  uint128_t p10 = (uint128_t)x1 * y[0];
+  uint128_t p11 = (uint128_t)x1 * y[1];
+  uint128_t mid = (p00 >> 64) + (uint64_t)p01 + (uint64_t)p10; // < 3*2**64
+  uint128_t lo  = (mid << 64) | (uint64_t)p00;
+  uint128_t hi  = p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+  *nsh = 0;
+  if ((int64_t)(uint64_t)(hi >> 64) >= 0) {
+    // normalize
+    hi = (hi << 1) | (lo >> 127);
+    *nsh = 1;
+  }
+  return hi;
+}
+
+// Convert parsed source with non-zero mantissa to binary128 bit pattern, sign not included
+// *done = false indicates that the result can be 1 ULP below correctly rounded value
+// and has to be checked with slowCvt()
+static uint128_t quickCore(const parse_t* src, int roundingMode, bool* done)
+{
+  *done = true;
+  const uint128_t mnt = src->mnt;
+  const int lz = clz128(mnt);
+  uint128_t r = mnt << lz;
+  if (src->hexFloat)
+    return roundToQuad(r | src->sticky, src->exp + 127 - lz, roundingMode); // exact
+
+  const int decExp = src->exp;
+  if (decExp + src->nd > POW10_MAX+1)
+    return roundingMode == FE_TOWARDZERO ? uMAX : uINF; // >= 10**4933
+  if (decExp + src->nd < POW10_MIN+MNT_DIGITS)
+    return roundingMode == FE_UPWARD ? 1 : 0; // < 10**-4965
+
+  // decExp range [POW10_MIN:POW10_MAX]
+  // 10**decExp = 10**(kH*POW10_FINE) * 10**kL
+  // r*pow5tab[kL]*pow10coarse[kH] is a lower estimate of the result. Its error comes from truncation of pow10coarse[]
+  // and of two products, each below 1 in units of LS bit of the respective upper half, i.e. below 6 in units of LS bit
+  // of the final product, and from digits, that did not fit in mnt.
+  // In the latter case mnt >= 10**37 > 2**122, so relative error is below 2**-122, i.e. below 2**6 in units of LS bit
+  int kH = (decExp - POW10_COARSE_MIN*POW10_FINE) / POW10_FINE + POW10_COARSE_MIN;
+  int kL = decExp - kH*POW10_FINE;
+  int e2 = 127 - lz + floorLog2Pow10(kL) + floorLog2Pow10(kH*POW10_FINE);
+  int nsh;
+  if (kL != 0) {
+    r = mulhi128(r, pow5tab[kL], &nsh);
+    e2 += 1 - nsh;
+  }
+  if (kH != 0) {
+    r = mulhi128(r, pow10coarse[kH-POW10_COARSE_MIN], &nsh);
+    e2 += 1 - nsh;
+  }
+  uint128_t err = src->sticky ? 8+64 : 8;
+  uint128_t res = roundToQuad(r, e2, roundingMode);
+  if (UNLIKELY(r + err < r || roundToQuad(r + err, e2, roundingMode) != res))
+    *done = false; // upper estimate rounds differently
+  return res;
+}
+
+// dst = dst * y, where dst is little-endian number of *nwords 32-bit words
+static void mp_mulw(uint32_t dst[], int* nwords, uint32_t y)
+{
+  uint64_t acc = 0;
+  int n = *nwords;
+  for (int i = 0; i < n; ++i) {
+    acc += (uint64_t)dst[i] * y;
+    dst[i] = (uint32_t)acc;
+    acc >>= 32;
+  }
+  if (acc)
+    dst[(*nwords)++] = (uint32_t)acc;
+}
+
+// dst = dst / y, return remainder
+static uint32_t mp_divw(uint32_t dst[], int* nwords, uint32_t y)
+{
+  uint64_t rem = 0;
+  for (int i = *nwords-1; i >= 0; --i) {
+    rem = (rem << 32) | dst[i];
+    dst[i] = (uint32_t)(rem / y);
+    rem %= y;
+  }
+  while (*nwords > 0 && dst[*nwords-1] == 0)
+    --(*nwords);
+  return (uint32_t)rem;
+}
+
+// dst = fractional part of dst * y, where dst is a fixed-point number with fb fraction bits.
+// Return integer part of dst * y, which has to be below 2**32.
+// Words of dst above *nwords are zero
+static uint32_t mp_mulfrac(uint32_t dst[], int* nwords, int fb, uint32_t y)
+{
+  mp_mulw(dst, nwords, y);
+  int wi = fb / 32;
+  int bi = fb % 32;
+  uint32_t res = (uint32_t)((((uint64_t)dst[wi+1] << 32) | dst[wi]) >> bi);
+  dst[wi] &= ((uint32_t)1 << bi) - 1;
+  dst[wi+1] = 0;
+  if (*nwords > wi+1)
+    *nwords = wi+1;
+  while (*nwords > 0 && dst[*nwords-1] == 0)
+    --(*nwords);
+  return res;
+}
+
+// write 9 decimal digits of x < 10**9 to dst
+static void u2dec9(char* dst, uint32_t x)
+{
+  for (int i = 8; i >= 0; --i) {
+    dst[i] = (char)('0' + x % 10);
+    x /= 10;
+  }
+}
+
+// cursor over significant digits of the source
+typedef struct {
+  const char* p;
+  const char* end;
+} srcDigits_t;
+
+// compare next n digits of the source (zeros beyond the end) with ref[]
+// return -1,0,+1 when source digits are respectively <, = or > of ref[]
+static int cmpSrcDigits(srcDigits_t* src, const char* ref, int n)
+{
+  for (int i = 0; i < n; ++i) {
+    while (src->p != src->end && (unsigned char)(*src->p - '0') > 9)
+      ++src->p; // skip dot
+    char c = src->p != src->end ? *src->p++ : '0';
+    if (c != ref[i])
+      return c > ref[i] ? 1 : -1;
+  }
+  return 0;
+}
+
+// return 1 when there are non-zero digits in the rest of the source, 0 otherwise
+static int srcDigitsNonZero(const srcDigits_t* src)
+{
+  for (const char* p = src->p; p != src->end; ++p) {
+    if ((unsigned char)(*p - '1') <= 8)
+      return 1;
+  }
+  return 0;
+}
+
+// Compare source with threshold between u and next binary128 number:
+// u+0.5ULP for rounding to nearest, u+1ULP for rounding toward zero, u for rounding away from zero
+// return -1,0,+1 when source string respectively <, = or > of the threshold
+static int compareSrcWithThreshold(const parse_t* src, uint128_t u, int roundingMode)
+{
+  // threshold = thr*2**binExp
+  int be = (int)(u >> 112);
+  uint128_t thr = u & (((uint128_t)1 << 112) - 1);
+  int binExp = (be ? be : 1) - 16383 - 112;
+  if (be)
+    thr |= (uint128_t)1 << 112;
+  if (roundingMode == FE_TONEAREST) {
+    thr = thr*2 + 1;
+    binExp -= 1;
+  } else if (roundingMode == FE_TOWARDZERO) {
+    thr += 1;
+  }
+  if (thr == 0)
+    return 1; // threshold is zero
+
+  srcDigits_t srcDig = { src->mntBeg, src->mntEnd };
+  int srcExp = src->exp + src->nd; // source = 0.mntBeg*10**srcExp
+  // Biggest threshold is (2**114)*2**16271 < 2**16386
+  // Smallest non-zero threshold is 2**-16495. Fixed-point fraction has up to 16495 bits
+  enum { NWORDS = 16496/32 + 3 };
+  uint32_t w[NWORDS] = {0};
+  int nw = 0;
+
+  if (binExp >= 0) {
+    // threshold is an integer. Convert it to decimal, starting from the LS digits
+    for (int i = 0; thr != 0; ++i, thr >>= 32)
+      w[binExp/32 + i] = (uint32_t)thr;
+    nw = binExp/32 + 4;
+    while (w[nw-1] == 0)
+      --nw;
+    mp_mulw(w, &nw, (uint32_t)1 << (binExp%32));
+    char buf[(NWORDS*32/29+1)*9];
+    char* bufEnd = &buf[sizeof(buf)];
+    char* thrDig = bufEnd;
+    while (nw > 0) {
+      thrDig -= 9;
+      u2dec9(thrDig, mp_divw(w, &nw, 1000000000u));
+    }
+    while (*thrDig == '0')
+      ++thrDig;
+    int thrExp = (int)(bufEnd - thrDig); // threshold = 0.thrDig*10**thrExp
+    if (srcExp != thrExp)
+      return srcExp > thrExp ? 1 : -1;
+    int cmp = cmpSrcDigits(&srcDig, thrDig, thrExp);
+    return cmp ? cmp : srcDigitsNonZero(&srcDig);
+  }
+
+  // threshold = thr/2**fb
+  int fb = -binExp;
+  char head[48];
+  int nHead = 0;
+  int thrExp = 0;
+  if (fb < 128 && (thr >> fb) != 0) {
+    // threshold >= 1. Decimal digits of integer part
+    uint128_t ip = thr >> fb;
+    thr -= ip << fb;
+    char* p = &head[sizeof(head)];
+    for (; ip != 0; ip /= 10)
+      *--p = (char)('0' + (unsigned)(ip % 10));
+    nHead = (int)(&head[sizeof(head)] - p);
+    memmove(head, p, nHead);
+    thrExp = nHead;
+    for (int i = 0; thr != 0; ++i, thr >>= 32)
+      w[i] = (uint32_t)thr;
+    nw = (fb + 31) / 32;
+  } else {
+    // threshold < 1. Scale it by 10**m so that threshold*10**m >= 10**-3 while still below 1
+    // m = floor((fb - bitlen(thr))*log10(2))
+    int m = ((fb - (128 - clz128(thr))) * 78913) >> 18;
+    for (int i = 0; thr != 0; ++i, thr >>= 32)
+      w[i] = (uint32_t)thr;
+    nw = 4;
+    while (nw > 0 && w[nw-1] == 0)
+      --nw;
+    int k = m;
+    for (; k > 13; k -= 13)
+      mp_mulw(w, &nw, 1220703125u); // 5**13
+    uint32_t pow5 = 1;
+    for (; k > 0; --k)
+      pow5 *= 5;
+    mp_mulw(w, &nw, pow5);
+    fb -= m; // threshold*10**m = w*2**(m-fb)
+    // leading digits
+    thrExp = -m;
+    while (nHead == 0) {
+      char dig9[9];
+      u2dec9(dig9, mp_mulfrac(w, &nw, fb, 1000000000u));
+      int lz = 0;
+      while (lz < 9 && dig9[lz] == '0')
+        ++lz;
+      thrExp -= lz;
+      nHead = 9 - lz;
+      memcpy(head, &dig9[lz], nHead);
+    }
+  }
+  if (srcExp != thrExp)
+    return srcExp > thrExp ? 1 : -1;
+  int cmp = cmpSrcDigits(&srcDig, head, nHead);
+  while (cmp == 0 && nw > 0) {
+    char dig9[9];
+    u2dec9(dig9, mp_mulfrac(w, &nw, fb, 1000000000u));
+    cmp = cmpSrcDigits(&srcDig, dig9, 9);
+  }
+  return cmp ? cmp : srcDigitsNonZero(&srcDig);
+}
+
+// Blitzkrieg didn't work, let's do it slowly
+static NOINLINE uint128_t slowCvt(const parse_t* src, uint128_t res, int roundingMode)
+{
+  int cmp = compareSrcWithThreshold(src, res, roundingMode);
+  if (roundingMode == FE_TONEAREST) {
+    cmp |= (int)(res & 1); // break tie to even
+    res += (cmp > 0);
+  } else if (roundingMode == FE_UPWARD) {
+    res += (cmp > 0);
+  } else {
+    res += (cmp >= 0);
+  }
+  return res;
+}
+
+// Decimal point character of the current locale of the calling thread
+static char decimalPoint(void)
+{
+#ifdef MY_STRTOD_LANGINFO
+  return nl_langinfo(RADIXCHAR)[0];
+#else
+  return localeconv()->decimal_point[0];
+#endif
+}
+
+__float128 my_strtoflt128(const char* str, char** str_end)
+{
+  parse_t prs;
+  const char* endp = parseSrc(&prs, str, decimalPoint());
+  if (str_end)
+    *str_end = (char*)(endp ? endp : str);
+  if (!endp)
+    return 0;
+
+  // Convert to floating point
+  if (prs.mnt == 0)
+    return u2q(prs.signBit);
+
+  int roundingMode = effRoundingMode(fegetround(), prs.signBit);
+  bool done;
+  uint128_t res = quickCore(&prs, roundingMode, &done);
+  if (UNLIKELY(!done))
+    res = slowCvt(&prs, res, roundingMode);
+  return u2q(res+prs.signBit);
+}
@@ -0,0 +1,162 @@
+// Hardware counters of the measured code: cycles, instructions, branch mispredictions and L1d misses.
+// On Linux counters are read by perf_event_open(), counting user mode of the calling thread only.
+// When perf_event_open() is not available (other OS, no PMU in VM, perf_event_paranoid) it falls back
+// to time stamp counter of x86, which counts reference cycles rather than core clock cycles.
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#ifdef __linux__
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <intrin.h>
+ #define PERF_COUNTERS_HAS_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+ #define PERF_COUNTERS_HAS_RDTSC
+#endif
+
+class perf_counters_t {
+public:
+  enum { CYCLES, INSTRUCTIONS, BRANCH_MISSES, L1D_MISSES, N_COUNTERS };
+  enum backend_t { NONE, PERF_EVENT, RDTSC };
+
+  perf_counters_t() : m_backend(NONE), m_tsc0(0) {
+    for (int i = 0; i < N_COUNTERS; ++i) {
+      m_fd[i] = -1;
+      m_id[i] = 0;
+      m_valid[i] = false;
+      m_val[i] = 0;
+    }
+    m_errStr[0] = 0;
+  }
+  ~perf_counters_t() {
+#ifdef __linux__
+    for (int i = N_COUNTERS-1; i >= 0; --i)
+      if (m_fd[i] >= 0)
+        close(m_fd[i]);
+#endif
+  }
+
+  // Return selected backend
+  backend_t open() {
+#ifdef __linux__
+    static const uint64_t config[N_COUNTERS] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_BRANCH_MISSES,
+      PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    };
+    for (int i = 0; i < N_COUNTERS; ++i) {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = i == L1D_MISSES ? PERF_TYPE_HW_CACHE : PERF_TYPE_HARDWARE;
+      attr.config = config[i];
+      attr.disabled = i == 0; // group is enabled and disabled by its leader
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID;
+      m_fd[i] = int(syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : m_fd[CYCLES], 0));
+      if (m_fd[i] < 0) {
+        if (i == 0) {
+          snprintf(m_errStr, sizeof(m_errStr), "perf_event_open: %s", strerror(errno));
+          break;
+        }
+        continue; // counter not supported by this CPU. Go on with the rest of the group
+      }
+      ioctl(m_fd[i], PERF_EVENT_IOC_ID, &m_id[i]);
+      m_valid[i] = true;
+    }
+    if (m_valid[CYCLES])
+      return m_backend = PERF_EVENT;
+#else
+    snprintf(m_errStr, sizeof(m_errStr), "perf_event_open: not supported by OS");
+#endif
+#ifdef PERF_COUNTERS_HAS_RDTSC
+    m_valid[CYCLES] = true;
+    return m_backend = RDTSC;
+#else
+    return m_backend = NONE;
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (m_backend == PERF_EVENT) {
+      ioctl(m_fd[CYCLES], PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+      ioctl(m_fd[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      return;
+    }
+#endif
+#ifdef PERF_COUNTERS_HAS_RDTSC
+    if (m_backend == RDTSC)
+      m_tsc0 = __rdtsc();
+#endif
+  }
+
+  void stop() {
+#ifdef PERF_COUNTERS_HAS_RDTSC
+    if (m_backend == RDTSC) {
+      m_val[CYCLES] = __rdtsc() - m_tsc0;
+      return;
+    }
+#endif
+#ifdef __linux__
+    if (m_backend == PERF_EVENT) {
+      ioctl(m_fd[CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+      struct { uint64_t nr; struct { uint64_t value, id; } v[N_COUNTERS]; } buf;
+      memset(&buf, 0, sizeof(buf));
+      if (read(m_fd[CYCLES], &buf, sizeof(buf)) <= 0)
+        return;
+      for (uint64_t k = 0; k < buf.nr && k < N_COUNTERS; ++k)
+        for (int i = 0; i < N_COUNTERS; ++i)
+          if (m_valid[i] && m_id[i] == buf.v[k].id)
+            m_val[i] = buf.v[k].value;
+    }
+#endif
+  }
+
+  backend_t   backend()      const { return m_backend; }
+  bool        valid(int i)   const { return m_valid[i]; }
+  uint64_t    value(int i)   const { return m_val[i]; }
+  // Reason of falling back from perf_event_open(). Empty string, when it is used
+  const char* errStr()       const { return m_errStr; }
+
+  // Print counters of the last start/stop interval, divided by the number of iterations
+  void print(const char* prefix, double nIter) const {
+    switch (m_backend) {
+      case PERF_EVENT:
+        printf("%s%.2f cycles/iter", prefix, m_val[CYCLES]/nIter);
+        if (m_valid[INSTRUCTIONS])
+          printf(", %.2f instructions/iter, IPC %.2f", m_val[INSTRUCTIONS]/nIter,
+            m_val[CYCLES] ? double(m_val[INSTRUCTIONS])/m_val[CYCLES] : 0.0);
+        if (m_valid[BRANCH_MISSES])
+          printf(", %.3f branch-misses/iter", m_val[BRANCH_MISSES]/nIter);
+        if (m_valid[L1D_MISSES])
+          printf(", %.3f L1d-misses/iter", m_val[L1D_MISSES]/nIter);
+        printf("\n");
+        break;
+      case RDTSC:
+        printf("%s%.2f TSC ticks/iter (%s, fallback to rdtsc)\n", prefix, m_val[CYCLES]/nIter, m_errStr);
+        break;
+      default:
+        printf("%shardware counters are not available (%s)\n", prefix, m_errStr);
+        break;
+    }
+  }
+
+private:
+  backend_t m_backend;
+  int       m_fd[N_COUNTERS];
+  uint64_t  m_id[N_COUNTERS];
+  bool      m_valid[N_COUNTERS];
+  uint64_t  m_val[N_COUNTERS];
+  uint64_t  m_tsc0;
+  char      m_errStr[128];
+};
@@ -0,0 +1,166 @@
+// Test correctness and speed of my_strtoflt128() against strtoflt128() from libquadmath.
+// Accepts test vectors in format, generated by gen_test1/gen_test2/gen_test3.
+// Expected binary64/binary32 values are ignored, strtoflt128() serves as a reference.
+// gcc only.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cfenv>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include <quadmath.h>
+
+extern "C" __float128 my_strtoflt128(const char* str, char** str_end);
+
+typedef unsigned __int128 uint128_t;
+
+static uint128_t q2u(__float128 x) {
+  uint128_t y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
+// run conversion of all strings of the plan, return nsec
+static double measure(__float128 (*fn)(const char*, char**), const std::vector<char*>& plan, int roundingMode, uint64_t* dummy)
+{
+  fesetround(roundingMode);
+  auto t0 = std::chrono::steady_clock::now();
+  uint64_t acc = 0;
+  for (size_t k = 0; k < plan.size(); ++k)
+    acc += (uint64_t)q2u(fn(plan[k], NULL));
+  auto t1 = std::chrono::steady_clock::now();
+  fesetround(FE_TONEAREST);
+  *dummy += acc;
+  return double(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+}
+
+int main(int argz, char** argv)
+{
+  if (argz < 2) {
+    fprintf(stderr,
+      "Usage:\n%s inp-file-name [nRep]\n"
+      "where\n"
+      "nRep - [optional] number of repetition during speed test. Default 1.\n"
+      , argv[0]);
+    return 1;
+  }
+
+  long nRep = 1;
+  for (int arg_i = 2; arg_i < argz; ++arg_i) {
+    char* arg = argv[arg_i];
+    if (arg[0] == '-') {
+      fprintf(stderr, "Unknown option '%s'.\n", arg);
+      return 1;
+    }
+    long v = strtol(arg, NULL, 0);
+    if (v > 0 && v < 1000000)
+      nRep = v;
+  }
+
+  FILE* fp = fopen(argv[1], "r");
+  if (!fp) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  // read input
+  std::vector<char*> inpv;
+  char buf[4096];
+  int roundingMode = FE_TONEAREST;
+  while (fgets(buf, sizeof(buf), fp)) {
+    size_t len = strlen(buf);
+    if (len > 17) {
+      char* p = new char[len+1];
+      memcpy(p, buf, len+1);
+      inpv.push_back(p);
+    } else if (inpv.empty() && len > 0) {
+      // first short line could contain control information
+      switch (buf[0]) {
+        case 'd':
+        case 'D':
+          roundingMode = FE_DOWNWARD;
+          break;
+
+        case 'u':
+        case 'U':
+          roundingMode = FE_UPWARD;
+          break;
+
+        case 'z':
+        case 'Z':
+          roundingMode = FE_TOWARDZERO;
+          break;
+
+        default:
+          break;
+      }
+    }
+  }
+  fclose(fp);
+
+  // test plan - source strings without expected values
+  size_t inplen = inpv.size();
+  std::vector<char*> srcv(inplen);
+  for (size_t k = 0; k < inplen; ++k) {
+    char* p = inpv[k];
+    if (*p == '+' || *p == '-')
+      ++p;
+    srcv[k] = &p[16];
+  }
+
+  // correctness test
+  int nErrors = 0;
+  for (size_t k = 0; k < inplen; ++k) {
+    char *refEnd, *endp;
+    fesetround(roundingMode);
+    __float128 ref = strtoflt128(srcv[k], &refEnd);
+    __float128 res = my_strtoflt128(srcv[k], &endp);
+    fesetround(FE_TONEAREST);
+    if (q2u(res) != q2u(ref) || endp != refEnd) {
+      if (nErrors < 1000) {
+        char refStr[64], resStr[64];
+        quadmath_snprintf(refStr, sizeof(refStr), "%.36Qe", ref);
+        quadmath_snprintf(resStr, sizeof(resStr), "%.36Qe", res);
+        fprintf(stderr,
+          "Test fail at #%zu\n%s"
+          "%s %d\n%s %d\n"
+          , k
+          , inpv[k]
+          , refStr, int(refEnd - srcv[k])
+          , resStr, int(endp - srcv[k])
+          );
+      }
+      ++nErrors;
+    }
+  }
+  if (nErrors > 0) {
+    printf("%d errors\n", nErrors);
+    return 1;
+  }
+  printf("ok.\n");
+  fflush(stdout);
+
+  // prepare plan of timing test;
+  std::vector<char*> rndinp(inplen*nRep);
+  for (size_t k = 0; k < inplen; ++k)
+    for (long i = 0; i < nRep; ++i)
+      rndinp[k*nRep+i] = srcv[k];
+  std::mt19937_64 gen;
+  gen.seed(1);
+  std::shuffle(rndinp.begin(), rndinp.end(), gen);
+
+  uint64_t dummy = 0;
+  double nsecRef = measure(strtoflt128,    rndinp, roundingMode, &dummy);
+  double nsecMy  = measure(my_strtoflt128, rndinp, roundingMode, &dummy);
+  printf("strtoflt128   : %.3f msec. %.2f nsec/iter\n", nsecRef*1e-6, nsecRef/(inplen*nRep));
+  printf("my_strtoflt128: %.3f msec. %.2f nsec/iter\n", nsecMy*1e-6,  nsecMy/(inplen*nRep));
+
+  for (auto it = inpv.begin(); it != inpv.end(); ++it)
+    delete [] *it;
+
+  return dummy==42? 42 :0;
+}
@@ -0,0 +1,223 @@
+// Loading of test vector, either in the text format of gen_test1/gen_test1m/gen_test2/gen_test3
+// or in binary container (test_vector_bin.h). Shared by clib_test and bench_all.
+// The file is memory-mapped, source strings and, for binary container, expected results and
+// tie annotations are used in place.
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cfenv>
+#include <vector>
+#include "test_vector_bin.h"
+#ifdef _WIN32
+ #define WIN32_LEAN_AND_MEAN
+ #ifndef NOMINMAX
+  #define NOMINMAX // std::min/std::max in the including code
+ #endif
+ #include <windows.h>
+#else
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+#endif
+
+// Private writable mapping of the whole file. Modifications are not written back to the file
+// Return NULL on failure
+inline char* mapFile(const char* name, size_t* pSize)
+{
+#ifdef _WIN32
+  HANDLE hFile = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (hFile == INVALID_HANDLE_VALUE) {
+    fprintf(stderr, "%s: can't open file. Error %lu.\n", name, GetLastError());
+    return NULL;
+  }
+  LARGE_INTEGER size;
+  char* ret = NULL;
+  if (GetFileSizeEx(hFile, &size)) {
+    *pSize = size_t(size.QuadPart);
+    if (*pSize == 0) {
+      static char empty[1];
+      ret = empty;
+    } else {
+      HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+      if (hMap) {
+        ret = (char*)MapViewOfFile(hMap, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(hMap);
+      }
+    }
+  }
+  if (!ret)
+    fprintf(stderr, "%s: can't map file. Error %lu.\n", name, GetLastError());
+  CloseHandle(hFile);
+  return ret;
+#else
+  int fd = open(name, O_RDONLY);
+  if (fd < 0) {
+    perror(name);
+    return NULL;
+  }
+  struct stat st;
+  char* ret = NULL;
+  if (fstat(fd, &st) == 0) {
+    *pSize = size_t(st.st_size);
+    if (*pSize == 0) {
+      static char empty[1];
+      ret = empty;
+    } else {
+      void* p = mmap(NULL, *pSize, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (p != MAP_FAILED)
+        ret = (char*)p;
+    }
+  }
+  if (!ret)
+    perror(name);
+  close(fd);
+  return ret;
+#endif
+}
+
+inline void unmapFile(char* data, size_t size)
+{
+  if (size == 0)
+    return;
+#ifdef _WIN32
+  UnmapViewOfFile(data);
+#else
+  munmap(data, size);
+#endif
+}
+
+// Parse control line of test vector: rounding mode character optionally followed by 'f' for binary32
+inline void parseControl(const char* ctrl, int* roundingMode, bool* f32)
+{
+  switch (ctrl[0]) {
+    case 'd':
+    case 'D':
+      *roundingMode = FE_DOWNWARD;
+      break;
+
+    case 'u':
+    case 'U':
+      *roundingMode = FE_UPWARD;
+      break;
+
+    case 'n':
+    case 'N':
+      *roundingMode = FE_TONEAREST;
+      break;
+
+    case 'z':
+    case 'Z':
+      *roundingMode = FE_TOWARDZERO;
+      break;
+
+    default:
+      break;
+  }
+  *f32 = ctrl[1] == 'f';
+}
+
+// Test vector: expected results, tie annotations and source strings.
+// Source strings point directly into the mapping. Each of them is terminated by '\n'.
+// For binary container expected results and tie annotations are used in place,
+// for text format they are parsed while indexing lines.
+struct test_vector_t {
+  char*                 fileData;
+  size_t                fileSize;
+  const uint64_t*       expected;
+  const int8_t*         ties;         // +1 - tie broken away from zero, -1 - toward zero, 0 - not a tie
+  std::vector<char*>    srcv;         // source strings, start after expected value
+  std::vector<char*>    srcEnd;       // terminating '\n' of source strings
+  int                   roundingMode;
+  bool                  f32;          // test vector of binary32 results
+  std::vector<uint64_t> expectedText;
+  std::vector<int8_t>   tiesText;
+  std::vector<char>     lastLine;     // copy of the last line of text, when it is not terminated by '\n'
+
+  test_vector_t() : fileData(NULL), fileSize(0), expected(NULL), ties(NULL), roundingMode(FE_TONEAREST), f32(false) {}
+  ~test_vector_t() {
+    if (fileData)
+      unmapFile(fileData, fileSize);
+  }
+  test_vector_t(const test_vector_t&) = delete;
+  test_vector_t& operator=(const test_vector_t&) = delete;
+
+  // Result res of conversion of item k differs from expected only by tie broken to odd.
+  // Not counted as error. Ties are annotated only for rounding to nearest
+  bool isTieBrokenToOdd(size_t k, uint64_t res) const {
+    return roundingMode == FE_TONEAREST && ties[k] != 0 && res == expected[k] - ties[k];
+  }
+};
+
+// Return false on failure, reported to stderr
+inline bool loadTestVector(const char* name, test_vector_t* tv)
+{
+  tv->fileData = mapFile(name, &tv->fileSize);
+  if (!tv->fileData)
+    return false;
+  char*  fileData = tv->fileData;
+  size_t fileSize = tv->fileSize;
+  const tvbin_header_t* bin = (const tvbin_header_t*)fileData;
+  if (fileSize >= sizeof(tvbin_header_t) && memcmp(bin->magic, TVBIN_MAGIC, sizeof(bin->magic))==0) {
+    // binary container
+    const char* err = tvbin_check_header(bin, fileSize);
+    if (err) {
+      fprintf(stderr, "%s: %s.\n", name, err);
+      return false;
+    }
+    const char ctrl[2] = { char(bin->roundingMode), char((bin->flags & TVBIN_F32) ? 'f' : 0) };
+    parseControl(ctrl, &tv->roundingMode, &tv->f32);
+    tv->expected = (const uint64_t*)&fileData[bin->expectedOffset];
+    tv->ties     = (const int8_t*)  &fileData[bin->tiesOffset];
+    const uint64_t* srcOffsets = (const uint64_t*)&fileData[bin->srcOffsetsOffset];
+    char* pool = &fileData[bin->poolOffset];
+    size_t nItems = size_t(bin->nItems);
+    tv->srcv.resize(nItems);
+    tv->srcEnd.resize(nItems);
+    for (size_t k = 0; k < nItems; ++k) {
+      uint64_t beg = srcOffsets[k], end = srcOffsets[k+1];
+      if (beg >= end || end > bin->poolSize || pool[end-1] != '\n') {
+        fprintf(stderr, "%s: corrupted source string #%zu.\n", name, k);
+        return false;
+      }
+      tv->srcv[k]   = &pool[beg];
+      tv->srcEnd[k] = &pool[end-1];
+    }
+  } else {
+    // text format. Every line is terminated by '\n', the last line is copied when it is not
+    for (size_t pos = 0; pos < fileSize;) {
+      char* line = &fileData[pos];
+      char* nl = (char*)memchr(line, '\n', fileSize - pos);
+      size_t len = nl ? size_t(nl - line) + 1 : fileSize - pos; // including '\n'
+      pos += len;
+      if (!nl) {
+        tv->lastLine.assign(line, line + len);
+        tv->lastLine.push_back('\n');
+        tv->lastLine.push_back(0);
+        line = tv->lastLine.data();
+        nl = &line[len];
+        ++len;
+      }
+      if (len > 17) {
+        int8_t tie = 0;
+        switch (*line) {
+          case '+': tie = +1; ++line; break;
+          case '-': tie = -1; ++line; break;
+          default: break;
+        }
+        tv->expectedText.push_back(strtoull(line, NULL, 16));
+        tv->tiesText.push_back(tie);
+        tv->srcv.push_back(&line[16]);
+        tv->srcEnd.push_back(nl);
+      } else if (tv->srcv.empty() && len > 0) {
+        // first short line could contain control information
+        parseControl(line, &tv->roundingMode, &tv->f32);
+      }
+    }
+    tv->expected = tv->expectedText.data();
+    tv->ties     = tv->tiesText.data();
+  }
+  return true;
+}
@@ -0,0 +1,190 @@
+// Binary container of test vector. Holds the same information as the text format, produced by
+// gen_test1/gen_test1m/gen_test2/gen_test3, but can be used directly after memory mapping.
+// Layout:
+//  header        - tvbin_header_t
+//  pool          - source strings, each is what follows expected value in the text format:
+//                  leading space, string to convert and terminating '\n'
+//  expected      - uint64_t[nItems], bit pattern of binary64 or, in LS bits, of binary32 result
+//  srcOffsets    - uint64_t[nItems+1], offsets of source strings within pool.
+//                  String k occupies [srcOffsets[k]:srcOffsets[k+1]), the last character is '\n'
+//  ties          - int8_t[nItems], +1 - tie broken away from zero ('+' prefix in the text format),
+//                  -1 - tie broken toward zero ('-' prefix), 0 - not a tie
+// Arrays are aligned on 8-byte boundary. Numbers are in byte order of the writer.
+#pragma once
+#include <cstdint>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static const char TVBIN_MAGIC[8] = { 'S','T','R','T','O','D','T','V' };
+enum {
+  TVBIN_VERSION    = 1,
+  TVBIN_BYTE_ORDER = 0x01020304,
+  TVBIN_F32        = 1, // flags: binary32 results
+};
+
+struct tvbin_header_t {
+  char     magic[8];         // TVBIN_MAGIC
+  uint32_t version;          // TVBIN_VERSION
+  uint32_t byteOrder;        // TVBIN_BYTE_ORDER
+  uint32_t flags;            // TVBIN_F32 or 0
+  uint32_t roundingMode;     // rounding mode character of control line of the text format: 'n', 'd', 'u' or 'z'
+  uint64_t nItems;
+  uint64_t poolOffset;       // offsets from the start of the file
+  uint64_t poolSize;
+  uint64_t expectedOffset;
+  uint64_t srcOffsetsOffset;
+  uint64_t tiesOffset;
+};
+
+// Writes binary container from the lines of the text format.
+// Source strings are written as they come. Arrays are streamed into temporary files and
+// appended by close(), so memory footprint does not depend on number of items
+class tvbin_writer_t {
+public:
+  tvbin_writer_t() : m_fp(NULL), m_name(NULL), m_poolSize(0), m_nItems(0) {
+    m_tmp[0] = m_tmp[1] = m_tmp[2] = NULL;
+  }
+  ~tvbin_writer_t() {
+    if (m_fp) fclose(m_fp);
+    closeTmp();
+  }
+
+  // roundingModeChar - 'n', 'd', 'u' or 'z'
+  bool open(const char* name, char roundingModeChar, bool f32) {
+    m_fp = fopen(name, "wb");
+    if (!m_fp) {
+      perror(name);
+      return false;
+    }
+    m_name = name;
+    for (int i = 0; i < N_TMP; ++i) {
+      m_tmp[i] = tmpfile();
+      if (!m_tmp[i]) {
+        perror("tmpfile");
+        return false;
+      }
+    }
+    memset(&m_hdr, 0, sizeof(m_hdr));
+    memcpy(m_hdr.magic, TVBIN_MAGIC, sizeof(m_hdr.magic));
+    m_hdr.version      = TVBIN_VERSION;
+    m_hdr.byteOrder    = TVBIN_BYTE_ORDER;
+    m_hdr.flags        = f32 ? TVBIN_F32 : 0;
+    m_hdr.roundingMode = roundingModeChar | 0x20; // lower case
+    m_hdr.poolOffset   = sizeof(m_hdr);
+    bool ok = write(m_tmp[TMP_SRC_OFFSETS], &m_poolSize, sizeof(m_poolSize))
+           && write(m_fp, &m_hdr, sizeof(m_hdr)); // placeholder, rewritten by close()
+    if (!ok)
+      perror(m_name);
+    return ok;
+  }
+
+  // line - test vector item in the text format: [+|-]expected-value-in-hex source-string\n
+  // Return false on write error, which is already reported to stderr
+  bool addLine(const char* line) {
+    int8_t tie = 0;
+    switch (*line) {
+      case '+': tie = +1; ++line; break;
+      case '-': tie = -1; ++line; break;
+      default: break;
+    }
+    char hex[17];
+    memcpy(hex, line, 16);
+    hex[16] = 0;
+    const char* src = &line[16];
+    size_t len = strlen(src);
+    uint64_t expected = strtoull(hex, NULL, 16);
+    m_poolSize += len;
+    ++m_nItems;
+    bool ok = write(m_fp, src, len)
+           && write(m_tmp[TMP_EXPECTED],     &expected,   sizeof(expected))
+           && write(m_tmp[TMP_SRC_OFFSETS], &m_poolSize, sizeof(m_poolSize))
+           && write(m_tmp[TMP_TIES],        &tie,        sizeof(tie));
+    if (!ok)
+      perror(m_name);
+    return ok;
+  }
+
+  bool close() {
+    // pad pool to 8-byte boundary
+    static const char zeros[8] = {0};
+    size_t pad = (8 - m_poolSize % 8) % 8;
+    bool ok = write(m_fp, zeros, pad);
+    m_hdr.nItems           = m_nItems;
+    m_hdr.poolSize         = m_poolSize;
+    m_hdr.expectedOffset   = m_hdr.poolOffset + m_poolSize + pad;
+    m_hdr.srcOffsetsOffset = m_hdr.expectedOffset + m_hdr.nItems*sizeof(uint64_t);
+    m_hdr.tiesOffset       = m_hdr.srcOffsetsOffset + (m_hdr.nItems+1)*sizeof(uint64_t);
+    for (int i = 0; ok && i < N_TMP; ++i)
+      ok = append(m_tmp[i]);
+    closeTmp();
+    ok = ok && fseek(m_fp, 0, SEEK_SET) == 0 && write(m_fp, &m_hdr, sizeof(m_hdr));
+    ok = (fclose(m_fp) == 0) && ok;
+    m_fp = NULL;
+    if (!ok)
+      perror(m_name);
+    return ok;
+  }
+
+private:
+  enum {
+    TMP_EXPECTED = 0, // the same order as in the file
+    TMP_SRC_OFFSETS,
+    TMP_TIES,
+    N_TMP,
+  };
+
+  static bool write(FILE* fp, const void* data, size_t len) {
+    return len == 0 || fwrite(data, 1, len, fp) == len;
+  }
+
+  // copy content of temporary file to the end of output
+  bool append(FILE* tmp) {
+    if (fflush(tmp) != 0 || fseek(tmp, 0, SEEK_SET) != 0)
+      return false;
+    char buf[1 << 16];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), tmp)) != 0) {
+      if (!write(m_fp, buf, len))
+        return false;
+    }
+    return !ferror(tmp);
+  }
+
+  void closeTmp() {
+    for (int i = 0; i < N_TMP; ++i) {
+      if (m_tmp[i])
+        fclose(m_tmp[i]);
+      m_tmp[i] = NULL;
+    }
+  }
+
+  FILE*                 m_fp;
+  FILE*                 m_tmp[N_TMP];
+  const char*           m_name;
+  tvbin_header_t        m_hdr;
+  uint64_t              m_poolSize;
+  uint64_t              m_nItems;
+};
+
+// Check header of binary container of size fileSize
+// Return NULL when o.k., otherwise description of the problem
+inline const char* tvbin_check_header(const tvbin_header_t* hdr, uint64_t fileSize)
+{
+  if (hdr->byteOrder != TVBIN_BYTE_ORDER)
+    return "wrong byte order";
+  if (hdr->version != TVBIN_VERSION)
+    return "unsupported version";
+  uint64_t n = hdr->nItems;
+  if (hdr->poolOffset < sizeof(*hdr)
+    || hdr->poolSize > fileSize
+    || hdr->expectedOffset   < hdr->poolOffset + hdr->poolSize
+    || hdr->expectedOffset   % 8 != 0
+    || n > fileSize / 17
+    || hdr->srcOffsetsOffset != hdr->expectedOffset   + n*sizeof(uint64_t)
+    || hdr->tiesOffset       != hdr->srcOffsetsOffset + (n+1)*sizeof(uint64_t)
+    || hdr->tiesOffset + n > fileSize)
+    return "inconsistent header";
+  return NULL;
+}
@@ -0,0 +1,77 @@
+// Fixed set of worker threads that stay alive for the whole run.
+// Used by option -j of gen_test2/gen_test3: every round of blocks is run by the same threads,
+// instead of creating and joining threads for each round.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class worker_pool_t {
+public:
+  // nThreads - number of workers, including the calling thread, which acts as worker 0
+  explicit worker_pool_t(unsigned nThreads)
+    : m_job(NULL), m_nActive(0), m_nPending(0), m_round(0), m_quit(false) {
+    for (unsigned t = 1; t < nThreads; ++t)
+      m_threads.push_back(std::thread(&worker_pool_t::threadFunc, this, t));
+  }
+
+  ~worker_pool_t() {
+    {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      m_quit = true;
+    }
+    m_start.notify_all();
+    for (auto& th : m_threads)
+      th.join();
+  }
+
+  // Call job(t) for t in range [0:n), n <= nThreads, each in its own worker.
+  // job(0) runs in the calling thread. Returns when all calls are completed
+  void run(unsigned n, const std::function<void(unsigned)>& job) {
+    {
+      std::lock_guard<std::mutex> lock(m_mtx);
+      m_job      = &job;
+      m_nActive  = n;
+      m_nPending = n - 1;
+      ++m_round;
+    }
+    if (n > 1)
+      m_start.notify_all();
+    job(0);
+    std::unique_lock<std::mutex> lock(m_mtx);
+    m_done.wait(lock, [this] { return m_nPending == 0; });
+  }
+
+private:
+  void threadFunc(unsigned t) {
+    uint64_t round = 0;
+    std::unique_lock<std::mutex> lock(m_mtx);
+    for (;;) {
+      m_start.wait(lock, [&] { return m_quit || m_round != round; });
+      if (m_quit)
+        return;
+      round = m_round;
+      if (t < m_nActive) {
+        const std::function<void(unsigned)>* job = m_job;
+        lock.unlock();
+        (*job)(t);
+        lock.lock();
+        if (--m_nPending == 0)
+          m_done.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread>                m_threads;
+  std::mutex                              m_mtx;
+  std::condition_variable                 m_start;
+  std::condition_variable                 m_done;
+  const std::function<void(unsigned)>*    m_job;
+  unsigned                                m_nActive;
+  unsigned                                m_nPending;
+  uint64_t                                m_round;
+  bool                                    m_quit;
+};
@@ -89,6 +89,32 @@ static int normailize96(uint32_t* pw2, uint32_t* pw1, uint32_t* pw0)
   return lz;
 }
 
+// 5**n for n in range [0:13]. Greater powers, up to 5**26, are products of two entries
+static const uint32_t Pow5Tab[14] = {
+  1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125,
+  9765625, 48828125, 244140625, 1220703125,
+};
+
+static uint64_t pow5(unsigned n)
+{ // n in range [0:26]
+  if (n < 14)
+    return Pow5Tab[n];
+  return (uint64_t)Pow5Tab[13] * Pow5Tab[n-13];
+}
+
+// *pw2:*pw1:*pw0 = x * y
+// the product and partial sums of middle word have to fit in 96 and 64 bits respectively
+static void mul96(uint32_t* pw2, uint32_t* pw1, uint32_t* pw0, uint64_t x, uint64_t y)
+{
+  uint32_t xL = (uint32_t)x, xH = (uint32_t)(x >> 32);
+  uint32_t yL = (uint32_t)y, yH = (uint32_t)(y >> 32);
+  uint64_t t0 = (uint64_t)xL * yL;
+  uint64_t t1 = (uint64_t)xL * yH + (uint64_t)xH * yL + (t0 >> 32);
+  *pw0 = (uint32_t)t0;
+  *pw1 = (uint32_t)t1;
+  *pw2 = xH * yH + (uint32_t)(t1 >> 32);
+}
+
 double
 __attribute__ ((cold))
 small_strtod(const char* str, char** endptr)
@@ -198,10 +224,28 @@ small_strtod(const char* str, char** endptr)
     uint32_t w1 = mant0;
     uint32_t w0 = 0;
     int bine = 63;
-    if (w2 == 0) {
+    // Mantissa below 2**34 (up to 10 digits) and small exponent are converted exactly:
+    // mant*10**mexp is calculated as 96-bit product mant*5**mexp.
+    // mant*10**-mexp, mexp <= 16, is scaled as usual, then near-midpoint results
+    // are resolved by exact comparison with 5**mexp times the midpoint
+    const uint64_t mant = ((uint64_t)mant1 << 32) | mant0;
+    const unsigned exactExp = mexp;
+    uint64_t exactPow5 = 0;
+    if (mant1 < 4 && sticky == 0 && mexp <= 26) {
+      exactPow5 = pow5(mexp);
+      if (!sexp) {
+        mul96(&w2, &w1, &w0, mant, exactPow5);
+        bine = 95 + mexp;
+        mexp = 0;
+      } else if (mexp > 16) {
+        exactPow5 = 0;
+      }
+    }
+    while (w2 == 0) {
       w2   = w1;
-      w1   = 0;
-      bine = 63 - 32;
+      w1   = w0;
+      w0   = 0;
+      bine -= 32;
     }
     for (;;) {
       // normalize mantissa
@@ -265,6 +309,23 @@ small_strtod(const char* str, char** endptr)
       } while (mexp >= decExp);
     }
     // printf("%08x:%08x:%08x\n", w2, w1, w0);
+    unsigned rem = w1 & 2047;
+    if (sexp && exactPow5 != 0 && (rem == 1023 || rem == 1024)) {
+      // Near midpoint. Compare mant*10**-exactExp with midpoint (2q+1)*2**(bine-53),
+      // where q is upper 53 bits of w2:w1, i.e. mant*2**s with (2q+1)*5**exactExp, s = 53-exactExp-bine
+      uint64_t q = (((uint64_t)w2 << 32) | w1) >> 11;
+      uint32_t r2, r1, r0;
+      mul96(&r2, &r1, &r0, q*2+1, exactPow5);
+      uint64_t rH = ((uint64_t)r2 << 32) | r1;
+      int s = 53 - (int)exactExp - bine; // mant < 2**34 and mant*2**s > 2**53, so s > 19
+      uint64_t lH = s >= 32 ? mant << (s - 32) : mant >> (32 - s);
+      uint32_t lL = s >= 32 ? 0                : (uint32_t)mant << s;
+      int cmp = (lH > rH) - (lH < rH);
+      if (cmp == 0)
+        cmp = (lL > r0) - (lL < r0);
+      w1 = (w1 - rem) + 1024 + cmp; // to_double() rounds up, down or to even
+      w0 = 0;
+    }
     w1 |= (((w0>>22) | sticky) != 0); // approximately 9-10 MS bits of w0 are good. The rest is garbage
     uret |= to_double(((uint64_t)w2 << 32) | w1, bine);
   }
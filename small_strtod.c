@@ -1,13 +1,77 @@
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
+#ifdef SMALL_STRTOD_SWAR
+// Optional parsing of 8 decimal digits at once, intended for 64-bit hosts.
+// Off by default, so default build keeps its minimal code footprint.
+
+// 8-byte load may read up to 7 bytes beyond the terminating zero. It never crosses page boundary,
+// so it can't fault, but AddressSanitizer reports it, so under sanitizer SWAR is not used
+#if defined(__SANITIZE_ADDRESS__)
+#define SMALL_STRTOD_SWAR_NO_OVERREAD 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define SMALL_STRTOD_SWAR_NO_OVERREAD 1
+#endif
+#endif
+
+static int swarCanLoad8(const char* p)
+{ // 8-byte load at p does not cross page boundary
+#ifdef SMALL_STRTOD_SWAR_NO_OVERREAD
+  (void)p;
+  return 0;
+#else
+  return ((uintptr_t)p & 4095) <= 4096-8;
+#endif
+}
+
+static uint64_t swarLoad8(const char* p)
+{
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  w = __builtin_bswap64(w); // first character in LS byte
+#endif
+  return w;
+}
+
+static int swarIs8Digits(uint64_t w)
+{ // each byte in range ['0':'9']
+  return ((w & 0xF0F0F0F0F0F0F0F0) | (((w + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4))
+         == 0x3333333333333333;
+}
+
+static uint32_t swarParse8Digits(uint64_t w)
+{ // w = 8 ASCII digits, the most significant in LS byte
+  w &= 0x0F0F0F0F0F0F0F0F;
+  w = (w * (10*256+1)) >> 8;                                  // 4 x 2 digits
+  w = ((w & 0x00FF00FF00FF00FF) * (100*65536+1)) >> 16;       // 2 x 4 digits
+  w = ((w & 0x0000FFFF0000FFFF) * ((10000ull << 32)+1)) >> 32; // 1 x 8 digits
+  return (uint32_t)w;
+}
+#endif
+
 // return # of digits
 static ptrdiff_t readDecimalDigits(const char* src, uint64_t* pVal, uint64_t maxVal, ptrdiff_t* pnUsed, int* sticky)
 {
   uint64_t val = *pVal;
-  ptrdiff_t nd, nUsed = 0;
+  ptrdiff_t nd = 0, nUsed = 0;
   unsigned lsb = 0;
-  for (nd = 0; ; ++nd) {
+#ifdef SMALL_STRTOD_SWAR
+  // consume 8 digits at once as long as all of them would be used by the loop below,
+  // i.e. as long as val*10**7 + 9999999 <= maxVal
+  const uint64_t swarLim = maxVal >= 9999999 ? (maxVal - 9999999)/10000000 + 1 : 0;
+  while (val < swarLim && swarCanLoad8(&src[nd])) {
+    uint64_t w = swarLoad8(&src[nd]);
+    if (!swarIs8Digits(w))
+      break;
+    val = val*100000000 + swarParse8Digits(w);
+    nUsed += 8;
+    nd    += 8;
+  }
+#endif
+  for (; ; ++nd) {
     unsigned c = src[nd];
     unsigned dig = c - '0';
     if (dig > 9)
@@ -17,6 +81,16 @@ static ptrdiff_t readDecimalDigits(const char* src, uint64_t* pVal, uint64_t max
       ++nUsed;
     } else {
       lsb |= dig;
+#ifdef SMALL_STRTOD_SWAR
+      // the rest of digits only contribute to sticky bit
+      while (swarCanLoad8(&src[nd+1])) {
+        uint64_t w = swarLoad8(&src[nd+1]);
+        if (!swarIs8Digits(w))
+          break;
+        lsb |= ((w & 0x0F0F0F0F0F0F0F0F) != 0);
+        nd  += 8;
+      }
+#endif
     }
   }
   *pVal = val;
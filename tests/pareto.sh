@@ -0,0 +1,103 @@
+#!/bin/sh
+# Code size vs speed report of small_strtod variants.
+# Every variant is compiled by every host compiler at -m32/-m64 and -Os/-O2. For every build the report
+# shows output of 'size', speed on corpus and rounding errors, measured by tst_speed.
+# Within each compiler and target, builds are sorted by size. Builds that are faster than every smaller
+# build form the Pareto front, column 'budget' shows the range of sizes (dec) for which the build wins.
+# Usage:
+# sh pareto.sh corpus [nRep] [errCorpus]
+# errCorpus - test vector for max/avg ULP errors. Default - corpus. Short canonical inputs of gen_test1
+#             are almost always converted correctly, inputs with 20-25 digits (gen_test2 20) are not.
+# Compilers are taken from PARETO_CC, default - gcc and clang, when installed.
+# Builds that can't be linked or run (e.g. -m32 without 32-bit C library) are reported without speed.
+
+corpus=$1
+nRep=${2:-20}
+errCorpus=${3:-$1}
+if [ -z "$corpus" ]; then
+  echo "Usage: sh $0 corpus [nRep] [errCorpus]" >&2
+  exit 1
+fi
+
+if [ -z "$PARETO_CC" ]; then
+  for c in gcc clang; do
+    command -v $c >/dev/null 2>&1 && PARETO_CC="$PARETO_CC $c"
+  done
+fi
+
+variants="small_strtod 64b_small_strtod n2_small_strtod w3_small_strtod"
+tmp=pareto_build
+mkdir -p $tmp
+rows=$tmp/rows.txt
+: >$rows
+
+for cc in $PARETO_CC; do
+  case $cc in
+    *clang*) cxx=$(echo $cc | sed 's/clang/clang++/') ;;
+    *)       cxx=$(echo $cc | sed 's/gcc/g++/') ;;
+  esac
+  for m in -m32 -m64; do
+    harness=$tmp/tst_speed$m.o
+    $cxx $m -std=c++11 -O2 -c tst_speed.cpp -o $harness 2>/dev/null || harness=
+    for opt in -Os -O2; do
+      for v in $variants; do
+        obj=$tmp/$v$m$opt.o
+        exe=$tmp/$v$m$opt
+        # size is measured as in ../code_density_comparison: freestanding, so it does not depend on
+        # presence of C library headers for the target
+        $cc $m $opt -std=c99 -c -ffreestanding -fbuiltin -I../code_density_comparison ../$v.c -o $obj 2>/dev/null || continue
+        # text data bss dec
+        sz=$(size $obj | awk 'NR==2 { print $1, $2, $3, $4 }')
+        nsec=; maxErr=; avgErr=
+        if [ -n "$harness" ] && $cc $m $opt -std=c99 -c ../$v.c -o $obj 2>/dev/null \
+          && $cxx $m $harness $obj -o $exe 2>/dev/null; then
+          # ok. N misrounded out of M. max err X ULP, avg err Y ULP.
+          # T msec. Z nsec/iter
+          nsec=$(./$exe $corpus $nRep | sed -n 's/.* msec\. \([^ ]*\) nsec\/iter.*/\1/p')
+          out=$(./$exe $errCorpus 1)
+          maxErr=$(echo "$out" | sed -n 's/.*max err \([^ ]*\) ULP.*/\1/p')
+          avgErr=$(echo "$out" | sed -n 's/.*avg err \([^ ]*\) ULP.*/\1/p')
+        fi
+        echo "$cc $m $opt $v $sz ${nsec:--} ${maxErr:--} ${avgErr:--}" >>$rows
+      done
+    done
+  done
+done
+
+echo "speed: $corpus x $nRep, errors: $errCorpus"
+sort -k1,1 -k2,2 -k8,8n -k9,9g $rows | awk '
+function flush(   i, best, last) {
+  # Pareto front: faster than every smaller build. Size budget of the winner extends up to the next one
+  best = -1; last = -1
+  for (i = 1; i <= n; ++i) {
+    budget[i] = ""
+    if (ns[i] != "-" && (best < 0 || ns[i] + 0 < best)) {
+      best = ns[i] + 0
+      if (last > 0)
+        budget[last] = budget[last] (dec[i] - 1)
+      budget[i] = dec[i] ".."
+      last = i
+    }
+  }
+  for (i = 1; i <= n; ++i)
+    print line[i] budget[i]
+  if (n > 0)
+    print ""
+  n = 0
+}
+BEGIN {
+  fmt = "%-8s %-4s %-4s %-17s %6s %6s %6s %6s %10s %8s %10s  "
+  printf(fmt "%s\n", "compiler", "", "", "variant", "text", "data", "bss", "dec", "nsec/iter", "max ULP", "avg ULP", "budget")
+}
+{
+  key = $1 " " $2
+  if (key != prevKey)
+    flush()
+  prevKey = key
+  ++n
+  dec[n] = $8
+  ns[n] = $9
+  line[n] = sprintf(fmt, $1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11)
+}
+END { flush() }
+'
@@ -35,6 +35,7 @@ int main(int argz, char** argv)
   double maxErr = 0;
   int tot = 0;
   int rnd = 0;
+  int rndObvious = 0; // rounding errors in "obvious" cases: mant*10**k, |k| < 17
   const uint64_t INF_PATTERN = (uint64_t)2047 << 52;
   for (int exp = minExp; exp <= maxExp; ++exp) {
     double expMinErr = 0;
@@ -89,6 +90,11 @@ int main(int argz, char** argv)
              , err
             );
           ++rnd;
+          int nd = 0; // # of digits in mant
+          for (int m = mant; m != 0; m /= 10)
+            ++nd;
+          if (exp - nd > -17 && exp - nd < 17)
+            ++rndObvious;
         }
       }
     }
@@ -100,6 +106,7 @@ int main(int argz, char** argv)
     fflush(stdout);
   }
   printf("o.k. %d rounding errors out of %d. %.3e percents. err [%+.10f..%+.10f] ULP.\n", rnd, tot, 1e2*rnd/tot, minErr, maxErr);
+  printf("%d rounding errors in obvious cases (|decimal exponent| < 17).\n", rndObvious);
 
   return 0;
 }
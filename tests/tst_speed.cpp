@@ -0,0 +1,141 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cinttypes>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+extern "C" double small_strtod(const char* str, char** endptr);
+
+static uint64_t d2u(double x) {
+  uint64_t y;
+  memcpy(&y, &x, sizeof(y));
+  return y;
+}
+
+// distance in ULPs between two binary64 bit patterns
+static uint64_t ulpDistance(uint64_t a, uint64_t b) {
+  const uint64_t SIGN = (uint64_t)1 << 63;
+  // map sign-magnitude to monotonic unsigned order
+  a = (a & SIGN) ? ~a : a | SIGN;
+  b = (b & SIGN) ? ~b : b | SIGN;
+  return a > b ? a - b : b - a;
+}
+
+int main(int argz, char** argv)
+{
+  if (argz < 2) {
+    fprintf(stderr,
+      "Usage:\n%s inp-file-name [nRep]\n"
+      "where\n"
+      "inp-file-name - test vector file, generated by ../big/gen_test1/gen_test2/gen_test3\n"
+      "nRep          - [optional] number of repetition during speed test. Default 1.\n"
+      , argv[0]);
+    return 1;
+  }
+
+  long nRep = 1;
+  if (argz > 2) {
+    long v = strtol(argv[2], NULL, 0);
+    if (v > 0 && v < 1000000)
+      nRep = v;
+  }
+
+  FILE* fp = fopen(argv[1], "r");
+  if (!fp) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  // read input
+  std::vector<char*> inpv;
+  char buf[4096];
+  while (fgets(buf, sizeof(buf), fp)) {
+    size_t len = strlen(buf);
+    if (len > 17) {
+      char* p = new char[len+1];
+      memcpy(p, buf, len+1);
+      inpv.push_back(p);
+    } else if (inpv.empty() && len > 0) {
+      // first short line could contain control information
+      if (buf[0] != 'n' && buf[0] != 'N') {
+        fprintf(stderr, "%s: directed rounding is not supported by small_strtod.\n", argv[1]);
+        return 1;
+      }
+      if (buf[1] == 'f') {
+        fprintf(stderr, "%s: binary32 test vectors are not supported by small_strtod.\n", argv[1]);
+        return 1;
+      }
+    }
+  }
+  fclose(fp);
+  if (inpv.empty()) {
+    fprintf(stderr, "%s: no test vectors.\n", argv[1]);
+    return 1;
+  }
+
+  // correctness test. small_strtod is not always correctly rounded, so errors are measured rather than rejected
+  int nErrors = 0;
+  int nMisrounded = 0;
+  uint64_t maxErr = 0;
+  double   sumErr = 0;
+  for (auto it = inpv.begin(); it != inpv.end(); ++it) {
+    char* str = *it;
+    if (*str == '+' || *str == '-')
+      ++str; // tie marker
+    uint64_t u = strtoull(&str[0], NULL, 16);
+    char* endp;
+    double d = small_strtod(&str[16], &endp);
+    if (endp == &str[16] || (*endp != '\n' && *endp != 0)) {
+      if (nErrors < 100)
+        fprintf(stderr, "Test fail at #%zu\n%s", it-inpv.begin(), *it);
+      ++nErrors;
+      continue;
+    }
+    uint64_t err = ulpDistance(d2u(d), u);
+    if (err != 0) {
+      ++nMisrounded;
+      if (err > maxErr)
+        maxErr = err;
+      sumErr += err;
+    }
+  }
+  if (nErrors > 0) {
+    printf("%d errors\n", nErrors);
+    return 1;
+  }
+  printf("ok. %d misrounded out of %zu. max err %" PRIu64 " ULP, avg err %.3e ULP.\n"
+    , nMisrounded, inpv.size(), maxErr, sumErr/inpv.size());
+  fflush(stdout);
+
+  // prepare plan of timing test;
+  size_t inplen = inpv.size();
+  std::vector<char*> rndinp(inplen*nRep);
+  for (size_t k = 0; k < inplen; ++k) {
+    char* p = inpv[k];
+    if (*p == '+' || *p == '-')
+      ++p;
+    p += 16;
+    for (long i = 0; i < nRep; ++i)
+      rndinp[k*nRep+i] = p;
+  }
+  std::mt19937_64 gen;
+  gen.seed(1);
+  std::shuffle(rndinp.begin(), rndinp.end(), gen);
+
+  auto t0 = std::chrono::steady_clock::now();
+  uint64_t dummy = 0;
+  for (size_t k = 0; k < inplen*nRep; ++k)
+    dummy += d2u(small_strtod(rndinp[k], NULL));
+  auto t1 = std::chrono::steady_clock::now();
+  auto nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0);
+  printf("%.3f msec. %.2f nsec/iter\n", nsec.count()*1e-6, double(nsec.count())/(inplen*nRep));
+
+  for (auto it = inpv.begin(); it != inpv.end(); ++it)
+    delete [] *it;
+
+  return dummy==42? 42 :0;
+}